@@ -15,12 +15,34 @@
 
 using namespace SPI_Own; // To make use of the SPI functionalities
 
+/// @brief The raw accelerations of the three axes, all from the same sensor frame
+struct LIS3DHSample {
+    int16_t x;
+    int16_t y;
+    int16_t z;
+};
 
 /// @brief Class for handling communication with the acceleromter
 class LIS3DH {
     private:
     LIS3DHSettings settings;
 
+    // How far the left-justified output registers are shifted right, which depends on the resolution of the power mode
+    uint8_t rawShift() {
+        if (this->settings.get_power_mode() == (PM) N)
+            return 16 - 10;
+        else if (this->settings.get_power_mode() == (PM) H)
+            return 16 - 12;
+        return 16 - 8;
+    }
+
+    // Reads the next two bytes of a burst read, low then high, as one axis
+    int16_t transferAxis(uint8_t shift) {
+        uint8_t low = SPI_Transfer((uint8_t)0x00);
+        uint8_t high = SPI_Transfer((uint8_t)0x00);
+        return (int16_t) ((uint16_t) high << 8 | low) >> shift;
+    }
+
     public:
 
     // Non default constructor initialized with the settings object
@@ -61,6 +83,12 @@ class LIS3DH {
         WriteByte(CTRL_REG1, curr_val);
     }
 
+    // Changes the frequency in the settings object and sets it
+    void setFreq(uint16_t frequency) {
+        this->settings.set_freq(frequency);
+        setFreq();
+    }
+
     // Sets the power mode as the one in the settings object
     void setPowerMode() {
         uint8_t curr_val1 = ReadByte(CTRL_REG1);
@@ -112,18 +140,83 @@ class LIS3DH {
         setFreq();
         setPowerMode();
         setMaxAccel();
+        // Block data update: an output register pair isn't overwritten by a new frame until both of its bytes were read
+        WriteByte(CTRL_REG4, ReadByte(CTRL_REG4) | (1 << BDU));
         delay(100);
     }
 
+    /*
+      Reads the raw accelerations of all three axes, OUT_X_L to OUT_Z_H, in a single SPI transaction. That takes one
+      chip select and one address byte instead of three of each, and the three axes come from the same sensor frame.
+    */
+    void getXYZRaw(LIS3DHSample& sample) {
+        getXYZRaw(&sample, 1);
+    }
+
+    /*
+      Reads count samples in a single SPI transaction. While the FIFO is enabled, the address rolls back to OUT_X_L
+      after OUT_Z_H and every sample read pops the next one out of the FIFO, so this drains count samples at once.
+    */
+    void getXYZRaw(LIS3DHSample* samples, uint8_t count) {
+        const uint8_t shift = rawShift();
+        SPI_BeginTransmission();
+        SPI_Transfer((uint8_t)0b11000000 | OUT_X_L);
+        for (uint8_t i = 0; i < count; i++) {
+            samples[i].x = transferAxis(shift);
+            samples[i].y = transferAxis(shift);
+            samples[i].z = transferAxis(shift);
+        }
+        SPI_EndTransmission();
+    }
+
+    /*
+      Puts the FIFO in stream mode, where it keeps the last 32 samples, and raises INT1 once it holds more than
+      watermark (at most 31) of them. Going through the bypass mode first empties the FIFO.
+    */
+    void setFIFO(uint8_t watermark) {
+        WriteByte(FIFO_CTRL_REG, (uint8_t) 0x00);
+        WriteByte(CTRL_REG5, ReadByte(CTRL_REG5) | (1 << FIFO_EN));
+        WriteByte(FIFO_CTRL_REG, (1 << FM1) | (watermark & FSS_MASK));
+        WriteByte(CTRL_REG3, ReadByte(CTRL_REG3) | (1 << I1_WTM));
+    }
+
+    /*
+      Sets the interrupt generator 1 to detect when the board is still. The generator sees the acceleration through the
+      high-pass filter, which takes gravity out, and INT1 goes high once all three axes stayed under threshold (see
+      Threshold_to_Byte) for duration samples at the data rate (at most 127), then goes low again as soon as one of them
+      goes over, when the board starts moving. Nothing is latched, so the pin itself tells which of the two it is.
+    */
+    void setStillInterrupt(uint8_t threshold, uint8_t duration) {
+        WriteByte(CTRL_REG2, ReadByte(CTRL_REG2) | (1 << HP_IA1));
+        ReadByte(REFERENCE); // Resets the high-pass filter to the current acceleration
+        WriteByte(INT1_THS, threshold & 0x7F);
+        WriteByte(INT1_DURATION, duration & 0x7F);
+        WriteByte(INT1_CFG, (1 << AOI) | (1 << ZLIE) | (1 << YLIE) | (1 << XLIE));
+        WriteByte(CTRL_REG3, ReadByte(CTRL_REG3) | (1 << I1_IA1));
+    }
+
+    /*
+      Restarts the still detection of setStillInterrupt(). Disabling the interrupt generator lowers INT1 and drops the
+      samples it already counted as still, and the high-pass filter is reset to the current acceleration before it is
+      enabled again, so INT1 only rises once the board was still for the whole duration from now on.
+    */
+    void restartStillInterrupt() {
+        const uint8_t config = ReadByte(INT1_CFG);
+        WriteByte(INT1_CFG, (uint8_t) 0x00);
+        ReadByte(INT1_SRC); // Clears the interrupt
+        ReadByte(REFERENCE);
+        WriteByte(INT1_CFG, config);
+    }
+
+    // Gets how many samples are waiting in the FIFO
+    uint8_t getFIFOLevel() {
+        return ReadByte(FIFO_SRC_REG) & FSS_MASK;
+    }
+
     // Gets the raw int16_t value from the acceleromter representing the x acceleration
     int16_t getXRaw() {
         int16_t data = ReadTwoBytes(OUT_X_L);
-        int shift = 16 - 8;
-        if (this->settings.get_power_mode() == (PM) N)
-            shift = 16 - 10;
-        else if (this->settings.get_power_mode() == (PM) H)
-            shift = 16 - 12;
-        return (int16_t) (data >> shift);
+        return (int16_t) (data >> rawShift());
     }
 
     // Gets the converted float value from the acceleromter representing the x acceleration in g
@@ -141,12 +234,7 @@ class LIS3DH {
     // Gets the raw int16_t value from the acceleromter representing the y acceleration
     int16_t getYRaw() {
         int16_t data = ReadTwoBytes(OUT_Y_L);
-        int shift = 16 - 8;
-        if (this->settings.get_power_mode() == (PM) N)
-            shift = 16 - 10;
-        else if (this->settings.get_power_mode() == (PM) H)
-            shift = 16 - 12;
-        return (int16_t) (data >> shift);
+        return (int16_t) (data >> rawShift());
     }
 
     // Gets the converted float value from the acceleromter representing the y acceleration in g
@@ -164,12 +252,7 @@ class LIS3DH {
     // Gets the raw int16_t value from the acceleromter representing the xzacceleration
     int16_t getZRaw() {
         int16_t data = ReadTwoBytes(OUT_Z_L);
-        int shift = 16 - 8;
-        if (this->settings.get_power_mode() == (PM) N)
-            shift = 16 - 10;
-        else if (this->settings.get_power_mode() == (PM) H)
-            shift = 16 - 12;
-        return (int16_t) (data >> shift);
+        return (int16_t) (data >> rawShift());
     }
 
     // Gets the converted float value from the acceleromter representing the z acceleration in g
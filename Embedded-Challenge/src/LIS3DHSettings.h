@@ -62,7 +62,7 @@ class LIS3DHSettings{
 
     // Getters
 
-    uint8_t get_freq() {
+    uint16_t get_freq() {
         return this->frequency;
     }
 
@@ -86,63 +86,85 @@ class LIS3DHSettings{
         return this->zen;
     }
 
+    // Setters
+
+    void set_freq(uint16_t freq) {
+        this->frequency = freq;
+    }
+
     /// @brief Converts the frequency setting to the corresponding byte
     /// @param curr_val takes the current value of the relevant register
-    /// @return the byte after converting the frequency as described in the datasheet
+    /// @return the byte after converting the frequency as described in the datasheet, unchanged if it isn't a data rate of the LIS3DH
     uint8_t Freq_to_Byte(uint8_t curr_val) {
+        uint8_t code;
         switch (this->frequency) {
-        case 0:
-            curr_val &= ~((uint8_t)0b1 << ORD0);
-            curr_val &= ~((uint8_t)0b1 << ORD1);
-            curr_val &= ~((uint8_t)0b1 << ORD2);
-            curr_val &= ~((uint8_t)0b1 << ORD3);
+        case 0: // Power down
+            code = 0b0000;
             break;
         case 1:
-            curr_val |= ((uint8_t)0b1 << ORD0);
-            curr_val &= ~((uint8_t)0b1 << ORD1);
-            curr_val &= ~((uint8_t)0b1 << ORD2);
-            curr_val &= ~((uint8_t)0b1 << ORD3);
+            code = 0b0001;
             break;
         case 10:
-            curr_val &= ~((uint8_t)0b1 << ORD0);
-            curr_val |= ((uint8_t)0b1 << ORD1);
-            curr_val &= ~((uint8_t)0b1 << ORD2);
-            curr_val &= ~((uint8_t)0b1 << ORD3);
+            code = 0b0010;
             break;
         case 25:
-            curr_val |= ((uint8_t)0b1 << ORD0);
-            curr_val |= ((uint8_t)0b1 << ORD1);
-            curr_val &= ~((uint8_t)0b1 << ORD2);
-            curr_val &= ~((uint8_t)0b1 << ORD3);
+            code = 0b0011;
             break;
         case 50:
-            curr_val &= ~((uint8_t)0b1 << ORD0);
-            curr_val &= ~((uint8_t)0b1 << ORD1);
-            curr_val = ((uint8_t)0b1 << ORD2);
-            curr_val &= ~((uint8_t)0b1 << ORD3);
+            code = 0b0100;
             break;
         case 100:
-            curr_val = ((uint8_t)0b1 << ORD0);
-            curr_val &= ~((uint8_t)0b1 << ORD1);
-            curr_val = ((uint8_t)0b1 << ORD2);
-            curr_val &= ~((uint8_t)0b1 << ORD3);
+            code = 0b0101;
             break;
         case 200:
-            curr_val &= ~((uint8_t)0b1 << ORD0);
-            curr_val = ((uint8_t)0b1 << ORD1);
-            curr_val = ((uint8_t)0b1 << ORD2);
-            curr_val &= ~((uint8_t)0b1 << ORD3);
+            code = 0b0110;
             break;
         case 400:
-            curr_val = ((uint8_t)0b1 << ORD0);
-            curr_val = ((uint8_t)0b1 << ORD1);
-            curr_val = ((uint8_t)0b1 << ORD2);
-            curr_val &= ~((uint8_t)0b1 << ORD3);
+            code = 0b0111;
+            break;
+        case 1620: // Low power mode only
+            code = 0b1000;
             break;
+        case 1344: // Normal and high resolution modes
+        case 5376: // Low power mode
+            code = 0b1001;
+            break;
+        default:
+            return curr_val;
         }
+        curr_val &= ~((uint8_t)0b1111 << ORD0);
+        curr_val |= code << ORD0;
         return curr_val;
     }
 
+    /// @brief Returns the slowest data rate of the LIS3DH, in Hz, at which reading rate times per second always gets a new sample
+    /// @param rate how many times per second the accelerometer is read
+    /// @return the data rate, or 0 if rate is faster than every data rate available in all the power modes
+    static constexpr uint16_t Freq_for_Rate(uint16_t rate) {
+        return (rate <= 1) ? 1 : (rate <= 10) ? 10 : (rate <= 25) ? 25 : (rate <= 50) ? 50 : (rate <= 100) ? 100 :
+               (rate <= 200) ? 200 : (rate <= 400) ? 400 : (rate <= 1344) ? 1344 : 0;
+    }
+
+    /// @brief Converts an acceleration to the units of the interrupt thresholds, which depend on the max absolute acceleration
+    /// @param mg the acceleration in thousandths of g
+    /// @return the threshold byte, between 1 and 127
+    uint8_t Threshold_to_Byte(uint16_t mg) {
+        uint16_t lsb = 16; // mg per unit
+        switch (this->max_accel) {
+        case 4:
+            lsb = 32;
+            break;
+        case 8:
+            lsb = 62;
+            break;
+        case 16:
+            lsb = 186;
+            break;
+        }
+        uint16_t units = (mg + lsb / 2) / lsb;
+        return (units < 1) ? 1 : (units > 127) ? 127 : units;
+    }
+
     /// @brief Converts the max absolute acceleration setting to the corresponding byte
     /// @param curr_val takes the current value of the relevant register
     /// @return the byte after converting the max absolute acceleration as described in the datasheet
@@ -43,6 +43,27 @@
 #ifndef OUT_Z_H
 #define OUT_Z_H (uint8_t) 0x2D
 #endif
+#ifndef FIFO_CTRL_REG
+#define FIFO_CTRL_REG (uint8_t) 0x2E
+#endif
+#ifndef FIFO_SRC_REG
+#define FIFO_SRC_REG (uint8_t) 0x2F
+#endif
+#ifndef REFERENCE
+#define REFERENCE (uint8_t) 0x26
+#endif
+#ifndef INT1_CFG
+#define INT1_CFG (uint8_t) 0x30
+#endif
+#ifndef INT1_SRC
+#define INT1_SRC (uint8_t) 0x31
+#endif
+#ifndef INT1_THS
+#define INT1_THS (uint8_t) 0x32
+#endif
+#ifndef INT1_DURATION
+#define INT1_DURATION (uint8_t) 0x33
+#endif
 
 // Bit positions
 #ifndef FS0
@@ -69,3 +90,39 @@
 #ifndef HR
 #define HR 3
 #endif
+#ifndef BDU
+#define BDU 7
+#endif
+#ifndef I1_WTM
+#define I1_WTM 2
+#endif
+#ifndef FIFO_EN
+#define FIFO_EN 6
+#endif
+#ifndef FM0
+#define FM0 6
+#endif
+#ifndef FM1
+#define FM1 7
+#endif
+#ifndef FSS_MASK
+#define FSS_MASK (uint8_t) 0b00011111
+#endif
+#ifndef HP_IA1
+#define HP_IA1 0
+#endif
+#ifndef I1_IA1
+#define I1_IA1 6
+#endif
+#ifndef AOI
+#define AOI 7
+#endif
+#ifndef XLIE
+#define XLIE 0
+#endif
+#ifndef YLIE
+#define YLIE 2
+#endif
+#ifndef ZLIE
+#define ZLIE 4
+#endif
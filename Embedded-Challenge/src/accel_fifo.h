@@ -0,0 +1,77 @@
+/*
+    FIFO-backed acquisition, enabled with ACCEL_FIFO. Instead of the loop polling millis() to read the accelerometer at
+    the right times, the LIS3DH samples at its own data rate into its 32-level FIFO, in stream mode. Once the FIFO holds
+    more than ACCEL_FIFO_WATERMARK samples, it raises its INT1 pin, which is wired to D7 (PE6, INT6) on the Circuit
+    Playground, and the interrupt drains the whole FIFO in one burst into Accel_fifo_ring, where collect() picks the
+    samples up.
+    The samples are then evenly spaced whatever the loop was doing, and none are lost while it is blocked by sing() or by
+    the DTW, as long as the ring doesn't fill up.
+
+    The interrupt uses the SPI bus, so outside of it, the accelerometer must only be accessed with INT6 masked.
+
+    This file has to be included after LIS3DH.h.
+*/
+
+#ifdef __has_include
+    #if __has_include(<Arduino.h>)
+        #include <Arduino.h>
+    #endif
+#endif
+
+#ifndef SAMPLE_RING
+#define SAMPLE_RING 0
+#include "sample_ring.h"
+#endif
+
+#ifndef ACCEL_FIFO
+#define ACCEL_FIFO 0
+#endif
+
+#ifndef ACCEL_FIFO_WATERMARK
+#define ACCEL_FIFO_WATERMARK 8 // How many samples the FIFO holds before they are drained, at most 31
+#endif
+
+#ifndef ACCEL_FIFO_RING
+#define ACCEL_FIFO_RING 32 // How many samples the RAM ring holds, a power of 2 of at most 128
+#endif
+
+#if ACCEL_FIFO
+
+/// @brief The accelerometer the interrupt drains
+LIS3DH* Accel_fifo_sensor;
+
+/// @brief The samples drained from the FIFO, waiting for collect()
+SampleRing<ACCEL_FIFO_RING> Accel_fifo_ring;
+
+/// @brief Puts the accelerometer in FIFO stream mode and enables the interrupt that drains it
+void accel_fifo_begin(LIS3DH& sensor) {
+  Accel_fifo_sensor = &sensor;
+  sensor.setFIFO(ACCEL_FIFO_WATERMARK);
+  DDRE &= ~(1 << 6); // D7 as an input
+  EICRB |= (1 << ISC61) | (1 << ISC60); // INT6 on a rising edge
+  EIFR = (1 << INTF6);
+  EIMSK |= (1 << INT6);
+}
+
+/*
+  Drains the FIFO into the ring, in at most two bursts if the free space wraps around the end of the ring. The level is
+  read again until the FIFO is empty, since samples keep coming in while it is drained, and INT1 only rises again once
+  it went down. What doesn't fit in the ring is read out and dropped for the same reason.
+*/
+ISR(INT6_vect) {
+  uint8_t level;
+  while ((level = Accel_fifo_sensor->getFIFOLevel()) > 0) {
+    uint8_t count = level;
+    LIS3DHSample* free = Accel_fifo_ring.reserve(count);
+    if (count > 0) {
+      Accel_fifo_sensor->getXYZRaw(free, count);
+      Accel_fifo_ring.commit(count);
+    }
+    else {
+      LIS3DHSample dropped;
+      Accel_fifo_sensor->getXYZRaw(dropped);
+    }
+  }
+}
+
+#endif
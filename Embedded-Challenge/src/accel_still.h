@@ -0,0 +1,74 @@
+/*
+    Start condition detected by the accelerometer, enabled with ACCEL_STILL. Instead of check_start() computing the jerk
+    over the last idle samples, the interrupt generator of the LIS3DH watches the acceleration with gravity filtered out
+    (see LIS3DH::setStillInterrupt). Its INT1 pin, wired to D7 (PE6, INT6) on the Circuit Playground, rises once the
+    board was still for NO_MOTION_TIME seconds and falls as soon as it moves again. The idle state then only has to look
+    at the pin, and sleeps until it rises.
+    Nothing is latched, so the pin can already be high when the state goes back to idle, if the board was held still
+    while the chosen gesture was displayed for instance. The count is restarted whenever the data rate changes, which
+    includes every return to idle (see accel_still_arm), and the board is only taken as still once INT1 rose afterwards.
+
+    The ACT_THS and ACT_DUR activity detection can only be routed to INT2, which isn't wired on the Circuit Playground,
+    so the interrupt generator 1 is used instead. It shares INT1 with the FIFO watermark of ACCEL_FIFO.
+
+    This file has to be included after LIS3DH.h.
+*/
+
+#ifdef __has_include
+    #if __has_include(<Arduino.h>)
+        #include <Arduino.h>
+    #endif
+#endif
+
+#ifndef ACCEL_STILL
+#define ACCEL_STILL 0
+#endif
+
+#ifndef ACCEL_STILL_THRESHOLD
+#define ACCEL_STILL_THRESHOLD 96 // The most the board can move by on any axis while still, in thousandths of g
+#endif
+
+#if ACCEL_STILL
+
+#include <avr/sleep.h>
+
+static_assert(!ACCEL_FIFO, "ACCEL_STILL and ACCEL_FIFO both need the INT1 pin");
+
+/// @brief Makes the accelerometer signal on INT1 when it was still for duration samples at its data rate
+void accel_still_begin(LIS3DH& sensor, uint8_t threshold, uint8_t duration) {
+  sensor.setStillInterrupt(threshold, duration);
+  DDRE &= ~(1 << 6); // D7 as an input
+  EICRB |= (1 << ISC61) | (1 << ISC60); // INT6 on a rising edge
+  EIFR = (1 << INTF6);
+  EIMSK |= (1 << INT6);
+}
+
+/// @brief Whether INT1 rose since the count of still samples was last restarted
+volatile bool Accel_still_rose = false;
+
+/*
+  Restarts the count of still samples, so that the board has to be still for the whole duration from now on before
+  accel_still() returns true. Nothing else may access the accelerometer meanwhile.
+*/
+void accel_still_arm(LIS3DH& sensor) {
+  sensor.restartStillInterrupt();
+  EIFR = (1 << INTF6);
+  Accel_still_rose = false;
+}
+
+/// @brief Returns whether the accelerometer has been still for long enough since the count was last restarted
+inline bool accel_still() {
+  return Accel_still_rose && ((PINE >> 6) & 1);
+}
+
+/// @brief Halts the CPU until the next interrupt, the accelerometer's or any other
+inline void accel_still_sleep() {
+  set_sleep_mode(SLEEP_MODE_IDLE);
+  sleep_mode();
+}
+
+ISR(INT6_vect) {
+  Accel_still_rose = true;
+}
+
+#endif
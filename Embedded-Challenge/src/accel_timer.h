@@ -0,0 +1,85 @@
+/*
+    Timer-driven acquisition, enabled with ACCEL_TIMER. Instead of the loop comparing millis() against a floating point
+    period, Timer3 runs in CTC mode and its compare match interrupt reads the accelerometer every whole number of timer
+    ticks, which is 8 us at 8 MHz. The samples are pushed into Accel_timer_ring, where collect() picks them up, so they
+    are evenly spaced whatever the loop was doing. Changing the rate only changes the compare value.
+
+    The interrupt uses the SPI bus, so outside of it, the accelerometer must only be accessed with the timer interrupt
+    masked.
+
+    This file has to be included after LIS3DH.h.
+*/
+
+#ifdef __has_include
+    #if __has_include(<Arduino.h>)
+        #include <Arduino.h>
+    #endif
+#endif
+
+#ifndef SAMPLE_RING
+#define SAMPLE_RING 0
+#include "sample_ring.h"
+#endif
+
+#ifndef ACCEL_TIMER
+#define ACCEL_TIMER 0
+#endif
+
+#ifndef ACCEL_TIMER_RING
+#define ACCEL_TIMER_RING 16 // How many samples the RAM ring holds, a power of 2 of at most 128
+#endif
+
+#if ACCEL_TIMER
+
+static_assert(!ACCEL_FIFO, "ACCEL_TIMER and ACCEL_FIFO are two different ways of collecting the samples");
+
+/// @brief The prescaler of Timer3, a tick is accel_timer_prescaler / F_CPU seconds
+const uint8_t accel_timer_prescaler = 64;
+
+/// @brief The accelerometer the interrupt reads
+LIS3DH* Accel_timer_sensor;
+
+/// @brief The samples read by the interrupt, waiting for collect()
+SampleRing<ACCEL_TIMER_RING> Accel_timer_ring;
+
+/// @brief The rate the timer currently reads at, in Hz
+uint16_t Accel_timer_frequency = 0;
+
+/*
+  Makes the timer read rate samples per second, the period being rounded to the closest whole number of ticks (at most
+  65536, so at least 2 Hz at 8 MHz). The counter restarts so that the first sample at the new rate is a whole period
+  away, and the samples read at the previous rate are dropped. Returns whether the rate changed.
+*/
+bool accel_timer_rate(uint16_t rate) {
+  if (rate == Accel_timer_frequency) {
+    return false;
+  }
+  Accel_timer_frequency = rate;
+  const uint16_t ticks = (F_CPU / accel_timer_prescaler + rate / 2) / rate;
+  const uint8_t sreg = SREG; // The 16 bit timer registers are written through a shared temporary register
+  cli();
+  OCR3A = ticks - 1;
+  TCNT3 = 0;
+  SREG = sreg;
+  Accel_timer_ring.clear();
+  return true;
+}
+
+/// @brief Starts the timer reading the accelerometer rate times per second
+void accel_timer_begin(LIS3DH& sensor, uint16_t rate) {
+  Accel_timer_sensor = &sensor;
+  TCCR3A = 0;
+  TCCR3B = (1 << WGM32) | (1 << CS31) | (1 << CS30); // CTC mode up to OCR3A, prescaled by 64
+  accel_timer_rate(rate);
+  TIFR3 = (1 << OCF3A);
+  TIMSK3 |= (1 << OCIE3A);
+}
+
+/// @brief Reads a sample, dropped if the ring is full since collect() isn't being called
+ISR(TIMER3_COMPA_vect) {
+  LIS3DHSample sample;
+  Accel_timer_sensor->getXYZRaw(sample);
+  Accel_timer_ring.push(sample);
+}
+
+#endif
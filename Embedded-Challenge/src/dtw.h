@@ -0,0 +1,1147 @@
+/*
+    Dynamic Time Warping (DTW) engine used to compare the collected data against the recordings in gestures.h.
+    Every entry of the DTW matrix only depends on the entry to its left, the one above it, and the one diagonally
+    above-left of it. Because of that, the whole matrix never needs to be held in memory: a single row is kept and
+    updated in place, which frees most of the SRAM the full matrix used to occupy.
+
+    Our gestures never warp by more than a few samples, so by default only the cells close to the diagonal are
+    visited (a Sakoe-Chiba band of DTW_BAND_RADIUS samples, selected through DTW_WINDOW), and only the band is stored.
+    With a radius of 4 on 20 samples, 160 cells are visited instead of 400.
+
+    Two kernels are available and selected at compile time through DTW_KERNEL:
+    - DTW_KERNEL_FLOAT computes the Euclidean distance between samples in soft-float, like the original implementation
+    - DTW_KERNEL_INT works directly on the int16_t samples and accumulates an integer cell cost (chosen through DTW_COST)
+      in a saturating accumulator, so no sqrt() or pow() is ever called while classifying
+    On the recordings in gestures.h, both L1 and squared L2 integer costs pick the same closest recording as the
+    Euclidean float kernel does for every recording. Against the centroids, with the recordings stretched by 0.8 to 1.2
+    times and noise added as queries, L1, Chebyshev and the weighted L1 got all 1000 right, squared L2 993 and the
+    magnitude only cost 951. L1 is the default since it is also the cheapest to accumulate. On an AVR, the inner loop of
+    the narrow L1 (DTW_COST_NARROW_L1) can also be run by the hand-written assembly in dtw_asm.h, selected through
+    DTW_ASM_KERNEL.
+
+    Each recording is matched at its own length, which can differ from the length of the query: the window then follows
+    the diagonal of the rectangular DTW matrix instead of the square one, so a shorter recording also visits fewer cells.
+    Since a longer recording accumulates more cells along its warping path, the distances handed out by calculate_DTW(),
+    the lower bounds and the other classifiers are normalised by the length of the recording (see dtw_normalise).
+
+    This file has to be included after collecter_size has been defined and after gesture_tables.h.
+*/
+
+#ifdef __has_include
+    #if __has_include(<Arduino.h>)
+        #include <Arduino.h>
+    #endif
+#endif
+
+// Available DTW kernels
+#define DTW_KERNEL_FLOAT 0 // Euclidean cell cost computed in floating point
+#define DTW_KERNEL_INT 1 // Integer cell cost with a saturating accumulator
+
+// Available cell costs for the integer kernel
+#define DTW_COST_L1 0 // |dx| + |dy| + |dz| accumulated in a uint32_t
+#define DTW_COST_SQ_L2 1 // dx^2 + dy^2 + dz^2 accumulated in a uint32_t
+#define DTW_COST_CHEBYSHEV 2 // max(|dx|, |dy|, |dz|) accumulated in a uint32_t
+#define DTW_COST_MAGNITUDE 3 // Difference between the magnitudes of the accelerations, ignores the orientation of the board
+#define DTW_COST_WEIGHTED_L1 4 // L1 with a weight per axis (DTW_WEIGHT_X, DTW_WEIGHT_Y, DTW_WEIGHT_Z)
+#define DTW_COST_NARROW_L1 5 // L1 accumulated in a uint16_t, which motions much harder than the recordings can saturate
+
+#ifndef DTW_KERNEL
+#define DTW_KERNEL DTW_KERNEL_INT
+#endif
+#ifndef DTW_COST
+#define DTW_COST DTW_COST_L1
+#endif
+
+// Axis weights of DTW_COST_WEIGHTED_L1, in quarters (4 weighs an axis like DTW_COST_L1 does)
+#ifndef DTW_WEIGHT_X
+#define DTW_WEIGHT_X 4
+#endif
+#ifndef DTW_WEIGHT_Y
+#define DTW_WEIGHT_Y 4
+#endif
+#ifndef DTW_WEIGHT_Z
+#define DTW_WEIGHT_Z 4
+#endif
+
+/// @brief Adds two integer costs, saturating at the largest value so that unreachable cells stay unreachable
+template <class T>
+inline T dtw_add(T a, T b) {
+  T sum = a + b;
+  return (sum < a) ? (T) ~(T) 0 : sum;
+}
+
+/// @brief Adds two floating point costs, INFINITY already stays INFINITY
+inline float dtw_add(float a, float b) {
+  return a + b;
+}
+
+/*
+  Cell cost metrics. Each metric is a policy type that gives the type its costs are accumulated in, the value of an
+  unreachable cell, and two costs:
+  - match() is the cost of matching a template sample against a query sample
+  - cost() is the cost for samples whose accelerations differ by dx, dy and dz. It has to be a lower bound of match() for
+    any two samples that are at least that far apart on every axis, which is what LB_Keogh relies on
+  The engine is written against DTWMetric (chosen through DTW_KERNEL and DTW_COST), and dtw_fixed() takes the metric as
+  a template parameter.
+*/
+
+/// @brief Base of the metrics that only depend on the differences between the accelerations
+template <class Metric, class Cost>
+struct DifferenceMetric {
+  static inline Cost match(int16_t tx, int16_t ty, int16_t tz, int16_t qx, int16_t qy, int16_t qz) {
+    return Metric::cost(tx - qx, ty - qy, tz - qz);
+  }
+};
+
+/// @brief Euclidean distance computed in floating point
+struct EuclideanMetric : DifferenceMetric<EuclideanMetric, float> {
+  typedef float cost_t;
+  static constexpr cost_t infinity = INFINITY;
+  static inline cost_t cost(int16_t dx, int16_t dy, int16_t dz) {
+    return sqrt((float) dx * dx + (float) dy * dy + (float) dz * dz);
+  }
+};
+
+/*
+  |dx| + |dy| + |dz|, accumulated in Cost. The worst DTW distance between the recordings in gestures.h is ~23000, which
+  fits in a uint16_t (NarrowL1Metric), but a live motion about four times as hard as the recordings saturates it: every
+  distance then comes out as the largest value and the gesture is classified as unknown. L1Metric accumulates in a
+  uint32_t instead, which no path of 12-bit samples can saturate.
+*/
+template <class Cost>
+struct BasicL1Metric : DifferenceMetric<BasicL1Metric<Cost>, Cost> {
+  typedef Cost cost_t;
+  static constexpr cost_t infinity = (Cost) ~(Cost) 0;
+  static inline cost_t cost(int16_t dx, int16_t dy, int16_t dz) {
+    return (cost_t) (uint16_t) (dx < 0 ? -dx : dx) + (uint16_t) (dy < 0 ? -dy : dy) + (uint16_t) (dz < 0 ? -dz : dz);
+  }
+};
+typedef BasicL1Metric<uint32_t> L1Metric;
+typedef BasicL1Metric<uint16_t> NarrowL1Metric;
+
+/// @brief dx^2 + dy^2 + dz^2, accumulated in a uint32_t
+struct SquaredL2Metric : DifferenceMetric<SquaredL2Metric, uint32_t> {
+  typedef uint32_t cost_t;
+  static constexpr cost_t infinity = UINT32_MAX;
+  static inline cost_t cost(int16_t dx, int16_t dy, int16_t dz) {
+    return (uint32_t) ((int32_t) dx * dx) + (uint32_t) ((int32_t) dy * dy) + (uint32_t) ((int32_t) dz * dz);
+  }
+};
+
+/// @brief max(|dx|, |dy|, |dz|), accumulated in a uint32_t
+struct ChebyshevMetric : DifferenceMetric<ChebyshevMetric, uint32_t> {
+  typedef uint32_t cost_t;
+  static constexpr cost_t infinity = UINT32_MAX;
+  static inline cost_t cost(int16_t dx, int16_t dy, int16_t dz) {
+    return max((uint16_t) (dx < 0 ? -dx : dx), max((uint16_t) (dy < 0 ? -dy : dy), (uint16_t) (dz < 0 ? -dz : dz)));
+  }
+};
+
+/*
+  wx * |dx| + wy * |dy| + wz * |dz| with the weights in quarters, accumulated in a uint32_t. With the default weights (4,
+  4, 4) it computes the same distances as L1Metric, it's only worth selecting with other weights.
+*/
+template <uint8_t WX, uint8_t WY, uint8_t WZ>
+struct WeightedL1Metric : DifferenceMetric<WeightedL1Metric<WX, WY, WZ>, uint32_t> {
+  typedef uint32_t cost_t;
+  static constexpr cost_t infinity = UINT32_MAX;
+  static inline cost_t cost(int16_t dx, int16_t dy, int16_t dz) {
+    return ((uint32_t) WX * (uint16_t) (dx < 0 ? -dx : dx) + (uint32_t) WY * (uint16_t) (dy < 0 ? -dy : dy) +
+            (uint32_t) WZ * (uint16_t) (dz < 0 ? -dz : dz)) / 4;
+  }
+};
+
+/*
+  |(|t| - |q|)|, the difference between the magnitudes of the template and query accelerations, accumulated in a
+  uint32_t. It only compares how hard the board is moved, not in which direction, so it doesn't care how the board is
+  held. The magnitudes are approximated without a square root as max + 3/8 mid + 1/4 min of the absolute axes, which is
+  within -6% and +10% of the true magnitude. Nothing can be said about the difference of the magnitudes from the
+  per-axis differences alone, so its cost() is 0 and LB_Keogh never prunes with it.
+*/
+struct MagnitudeMetric {
+  typedef uint32_t cost_t;
+  static constexpr cost_t infinity = UINT32_MAX;
+
+  /// @brief Approximates the magnitude of an acceleration
+  static inline uint16_t magnitude(int16_t x, int16_t y, int16_t z) {
+    uint16_t a = (x < 0) ? -x : x;
+    uint16_t b = (y < 0) ? -y : y;
+    uint16_t c = (z < 0) ? -z : z;
+    // Sorting so that a >= b >= c
+    if (a < b) {
+      uint16_t swap = a; a = b; b = swap;
+    }
+    if (b < c) {
+      uint16_t swap = b; b = c; c = swap;
+    }
+    if (a < b) {
+      uint16_t swap = a; a = b; b = swap;
+    }
+    return a + (b >> 2) + (b >> 3) + (c >> 2);
+  }
+
+  static inline cost_t match(int16_t tx, int16_t ty, int16_t tz, int16_t qx, int16_t qy, int16_t qz) {
+    uint16_t t = magnitude(tx, ty, tz);
+    uint16_t q = magnitude(qx, qy, qz);
+    return (t > q) ? t - q : q - t;
+  }
+
+  static inline cost_t cost(int16_t, int16_t, int16_t) {
+    return 0;
+  }
+};
+
+#if DTW_KERNEL == DTW_KERNEL_FLOAT
+typedef EuclideanMetric DTWMetric;
+#elif DTW_COST == DTW_COST_L1
+typedef L1Metric DTWMetric;
+#elif DTW_COST == DTW_COST_SQ_L2
+typedef SquaredL2Metric DTWMetric;
+#elif DTW_COST == DTW_COST_CHEBYSHEV
+typedef ChebyshevMetric DTWMetric;
+#elif DTW_COST == DTW_COST_MAGNITUDE
+typedef MagnitudeMetric DTWMetric;
+#elif DTW_COST == DTW_COST_NARROW_L1
+typedef NarrowL1Metric DTWMetric;
+#else
+typedef WeightedL1Metric<DTW_WEIGHT_X, DTW_WEIGHT_Y, DTW_WEIGHT_Z> DTWMetric;
+#endif
+
+typedef DTWMetric::cost_t dtw_cost_t;
+#define DTW_INFINITY ((dtw_cost_t) DTWMetric::infinity)
+
+/// @brief Computes the cost of matching a template sample against a query sample
+/// @param tx the x acceleration of the template sample
+/// @param ty the y acceleration of the template sample
+/// @param tz the z acceleration of the template sample
+/// @param qx the x acceleration of the query sample
+/// @param qy the y acceleration of the query sample
+/// @param qz the z acceleration of the query sample
+/// @return the cell cost in the units of the chosen kernel
+inline dtw_cost_t dtw_cell_cost(int16_t tx, int16_t ty, int16_t tz, int16_t qx, int16_t qy, int16_t qz) {
+  return DTWMetric::match(tx, ty, tz, qx, qy, qz);
+}
+
+/// @brief Computes a lower bound of the cell cost for samples that are at least dx, dy and dz apart on each axis
+inline dtw_cost_t dtw_axis_cost(int16_t dx, int16_t dy, int16_t dz) {
+  return DTWMetric::cost(dx, dy, dz);
+}
+
+// Available warping windows
+#define DTW_WINDOW_NONE 0 // Every cell of the matrix is visited
+#define DTW_WINDOW_SAKOE_CHIBA 1 // Only cells within DTW_BAND_RADIUS of the diagonal are visited
+#define DTW_WINDOW_ITAKURA 2 // The Sakoe-Chiba band further narrowed to the Itakura parallelogram (slopes between 1/2 and 2)
+
+#ifndef DTW_WINDOW
+#define DTW_WINDOW DTW_WINDOW_SAKOE_CHIBA
+#endif
+#ifndef DTW_BAND_RADIUS
+#define DTW_BAND_RADIUS 4
+#endif
+
+// Whether the DTW is computed while the data is being collected (see dtw_stream_step)
+#ifndef DTW_STREAMING
+#define DTW_STREAMING 0
+#endif
+
+// Whether the streaming DTW can classify before the active window is over (see dtw_early_decision)
+#ifndef DTW_EARLY_DECISION
+#define DTW_EARLY_DECISION 0
+#endif
+#ifndef DTW_EARLY_MIN_SAMPLES
+#define DTW_EARLY_MIN_SAMPLES 8 // How many samples have to be collected before a decision can be taken
+#endif
+#ifndef DTW_EARLY_MARGIN
+#define DTW_EARLY_MARGIN 50 // How much more, in percent, the closest other gesture has to cost than the closest one
+#endif
+static_assert(!DTW_EARLY_DECISION || DTW_STREAMING, "DTW_EARLY_DECISION needs the partial costs of DTW_STREAMING");
+
+// Whether the templates are all matched together in a single sweep over the query (see classify_interleaved)
+#ifndef DTW_INTERLEAVED
+#define DTW_INTERLEAVED 0
+#endif
+
+/*
+  Whether a query is rejected as unknown when it is further from every template than the template's threshold (see
+  template_threshold). Off by default: the thresholds are only set from the recordings the templates were built from, so
+  how many real gestures they would turn away hasn't been measured on recordings held out of the templates.
+*/
+#ifndef DTW_REJECT
+#define DTW_REJECT 0
+#endif
+
+// How many templates, the closest by their summary features, are sent on to the DTW, 0 to send all of them (see dtw_candidates)
+#ifndef DTW_SHORTLIST
+#define DTW_SHORTLIST 0
+#endif
+#ifndef DTW_CROSSING_WEIGHT
+#define DTW_CROSSING_WEIGHT 8 // How much one zero crossing weighs in the feature distance, against the sample units
+#endif
+
+// Whether the templates are looked up through their symbolic (SAX) words before the DTW (see dtw_candidates)
+#ifndef DTW_SAX_INDEX
+#define DTW_SAX_INDEX 0
+#endif
+#ifndef DTW_SAX_SEGMENTS
+#define DTW_SAX_SEGMENTS 10 // How many PAA segments a word has for each axis
+#endif
+#ifndef DTW_SAX_ALPHABET
+#define DTW_SAX_ALPHABET 16 // How many symbols each segment can take, at most 16
+#endif
+static_assert(DTW_SAX_ALPHABET >= 2 && DTW_SAX_ALPHABET <= 16, "A SAX symbol is stored in a nibble, so DTW_SAX_ALPHABET has to be between 2 and 16");
+
+// Whether the recordings are first compared at a coarser resolution and only the closest ones are refined (see dtw_multires.h)
+#ifndef DTW_MULTIRES
+#define DTW_MULTIRES 0
+#endif
+#ifndef DTW_MULTIRES_FACTOR
+#define DTW_MULTIRES_FACTOR 2 // How many samples are averaged into one at the coarse resolution
+#endif
+#ifndef DTW_MULTIRES_CANDIDATES
+#define DTW_MULTIRES_CANDIDATES 3 // How many of the closest recordings at the coarse resolution are refined
+#endif
+#ifndef DTW_MULTIRES_RADIUS
+#define DTW_MULTIRES_RADIUS 1 // How many samples the refined cells can be away from the projected coarse path
+#endif
+
+const uint8_t dtw_coarse_size = collecter_size / DTW_MULTIRES_FACTOR;
+
+/*
+  Whether calculate_DTW() uses the kernel specialised at compile time for the query length, radius and metric (see
+  dtw_fixed). It is reached by the single pass classifier of the 'p' state, the default one, for every template of
+  collecter_size samples (9 of the 10 centroids), the others still go through dtw_step(). The streaming, interleaved,
+  multiresolution and time-sliced classifiers keep their own loops and don't use it.
+*/
+#ifndef DTW_SPECIALISED_KERNEL
+#define DTW_SPECIALISED_KERNEL 1
+#endif
+
+/*
+  Whether the templates are stored packed in gesture_tables.h, one signed byte per axis instead of an int16_t (see
+  GestureReader). The tables have to be built with the same option, and then only hold the packed templates, which
+  halves their flash. Without centroids or orientation, the packed recordings replace those of gestures.h, which the
+  linker then drops. Off by default: packing rounds every axis by up to half its scale, up to 4 counts on the recordings
+  in gestures.h, so the distances are no longer exactly those of the original recordings.
+*/
+#ifndef DTW_PACKED_TEMPLATES
+#define DTW_PACKED_TEMPLATES 0
+#endif
+
+/*
+  Whether the rows of the narrow L1 kernel on packed recordings are updated by the AVR assembly in dtw_asm.h.
+  Experimental: test/test_embedded_dtw_asm checks it against dtw_row_reference() on a simulated atmega32u4
+  (`pio test -e simavr`), which has to pass before it is turned on for the board.
+*/
+#ifndef DTW_ASM_KERNEL
+#define DTW_ASM_KERNEL 0
+#endif
+static_assert(!DTW_ASM_KERNEL || DTW_PACKED_TEMPLATES, "DTW_ASM_KERNEL only runs on the packed recordings of DTW_PACKED_TEMPLATES");
+static_assert(!DTW_ASM_KERNEL || (DTW_KERNEL == DTW_KERNEL_INT && DTW_COST == DTW_COST_NARROW_L1),
+              "DTW_ASM_KERNEL only accumulates the L1 cost in 16 bits, it needs DTW_COST_NARROW_L1");
+
+/*
+  The longest recording that can be matched against the query. Each row of the band is centred on the diagonal of the
+  DTW matrix, which can then move forward by up to two samples from one query sample to the next.
+*/
+const uint8_t dtw_max_length = 2 * collecter_size - 1;
+
+#if DTW_WINDOW == DTW_WINDOW_NONE
+const uint8_t dtw_radius = dtw_max_length - 1;
+#else
+const uint8_t dtw_radius = DTW_BAND_RADIUS;
+#endif
+
+/*
+  The rolling DTW band. While the query sample i is being processed, band[j - c + dtw_radius + 1] holds the minimum
+  cost of matching the first i + 1 query samples against the first j + 1 template samples, for every j inside the window
+  of i, where c = dtw_center(i, m) is the template sample on the diagonal. Indexing the row relative to the diagonal means
+  each row only needs the width of the window. When the diagonal moves forward by s samples from row i - 1 to row i, entry
+  (i - 1, j) lands s places after (i, j), so the row can still be updated in place from left to right as long as the
+  diagonal neighbour (i - 1, j - 1) is kept in a register. The extra entries at each end are kept at DTW_INFINITY so that
+  neighbours outside the window are never picked.
+*/
+const uint8_t dtw_band_size = 2 * dtw_radius + 4;
+dtw_cost_t DTW_band[dtw_band_size];
+
+/// @brief Returns the template sample on the diagonal of the DTW matrix for the query sample i
+/// @param i the index of the query sample
+/// @param m the number of samples of the recording
+inline uint8_t dtw_center(uint8_t i, uint8_t m) {
+  const uint16_t last = collecter_size - 1;
+  return ((uint16_t) i * (m - 1) * 2 + last) / (2 * last); // Rounded to the nearest sample
+}
+
+/// @brief Computes the range of template samples that the query sample i can be matched against
+/// @param i the index of the query sample
+/// @param m the number of samples of the recording
+/// @param lo the first template sample inside the window
+/// @param hi the last template sample inside the window
+inline void dtw_window(uint8_t i, uint8_t m, uint8_t& lo, uint8_t& hi) {
+  const uint8_t c = dtw_center(i, m);
+  lo = (c > dtw_radius) ? c - dtw_radius : 0;
+  hi = (c + dtw_radius < m - 1) ? c + dtw_radius : m - 1;
+#if DTW_WINDOW == DTW_WINDOW_ITAKURA
+  // The warping path's slope has to stay between 1/2 and 2 times the slope of the diagonal, both from the start and
+  // towards the end
+  const uint16_t l = collecter_size - 1;
+  const uint16_t k = m - 1;
+  lo = max(lo, (uint8_t) ((i * k + 2 * l - 1) / (2 * l)));
+  if (2 * i > l) {
+    lo = max(lo, (uint8_t) (((2 * i - l) * k + l - 1) / l));
+  }
+  hi = min(hi, (uint8_t) min(2 * i * k / l, (l + i) * k / (2 * l)));
+#endif
+}
+
+/// @brief Scales a cost by num / den, saturating at the largest value
+template <class T>
+inline T dtw_scale(T cost, uint8_t num, uint8_t den) {
+  const T infinity = (T) ~(T) 0;
+  if (cost == infinity) {
+    return infinity;
+  }
+  T whole = cost / den;
+  T part = (T) ((uint16_t) (cost % den) * num / den);
+  if (whole > (T) (infinity - part) / num) {
+    return infinity;
+  }
+  return whole * num + part;
+}
+
+/// @brief Scales a floating point cost by num / den
+inline float dtw_scale(float cost, uint8_t num, uint8_t den) {
+  return cost * num / den;
+}
+
+/*
+  Normalises the DTW distance of a recording of m samples. A warping path between the query and the recording has at
+  most collecter_size + m - 1 cells, so the distance is divided by collecter_size + m, and multiplied by 2 * collecter_size
+  so that it stays in the same units (and unchanged) for a recording as long as the query.
+*/
+inline dtw_cost_t dtw_normalise(dtw_cost_t cost, uint8_t m) {
+  return dtw_scale(cost, 2 * collecter_size, collecter_size + m);
+}
+
+/// @brief Turns a normalised distance back into the distance of a recording of m samples, for use as a bound
+inline dtw_cost_t dtw_denormalise(dtw_cost_t cost, uint8_t m) {
+  return dtw_scale(cost, collecter_size + m, 2 * collecter_size);
+}
+
+/*
+  The templates the query is matched against. By default they are the recordings of gestures.h, but when the tables were
+  built with DTW_CENTROIDS (see tools/template_builder.cpp), all the recordings of a gesture are averaged into a single
+  centroid held in gesture_tables.h, so the number of DTW evaluations doesn't grow with the number of recordings. When the
+  tables were built with ORIENTATION_NORMALISE but without centroids, they are the recordings rotated into the canonical
+  frame of orientation.h, also held in gesture_tables.h. When the tables were built with DTW_PACKED_TEMPLATES, the
+  templates are described by PackedGestureDescriptor instead of GestureDescriptor, and the packed recordings are held in
+  gesture_tables.h as gesture_packed.
+*/
+#if GESTURE_TABLES_CENTROIDS
+#define DTW_TEMPLATES gesture_centroids
+#elif GESTURE_TABLES_ORIENTATION
+#define DTW_TEMPLATES gesture_oriented
+#elif DTW_PACKED_TEMPLATES
+#define DTW_TEMPLATES gesture_packed
+#else
+#define DTW_TEMPLATES gestures
+#endif
+
+const uint8_t dtw_num_templates = sizeof(DTW_TEMPLATES) / sizeof(DTW_TEMPLATES[0]);
+
+#if DTW_PACKED_TEMPLATES
+/// @brief Returns the codes { cx, cy, cz } of a packed template, in the flash
+inline const int8_t* template_data(uint8_t t) {
+  return (const int8_t*) pgm_read_ptr(&DTW_TEMPLATES[t].data);
+}
+#else
+/// @brief Returns the samples { ax, ay, az } of a template, in the flash
+inline const int16_t* template_data(uint8_t t) {
+  return (const int16_t*) pgm_read_ptr(&DTW_TEMPLATES[t].data);
+}
+#endif
+
+/// @brief Returns the number of samples of a template
+inline uint8_t template_length(uint8_t t) {
+  return pgm_read_byte(&DTW_TEMPLATES[t].length);
+}
+
+/// @brief Returns the gesture of a template, as an index in gesture_names
+inline uint8_t template_label(uint8_t t) {
+  return pgm_read_byte(&DTW_TEMPLATES[t].label);
+}
+
+/// @brief Returns which recording of its gesture a template is (for a centroid, the one the averaging started from)
+inline uint8_t template_trial(uint8_t t) {
+  return pgm_read_byte(&DTW_TEMPLATES[t].trial);
+}
+
+/// @brief The template index handed out when the query was rejected as unknown
+const uint8_t dtw_unknown = UINT8_MAX;
+
+/*
+  Returns the largest normalised distance at which a query is still accepted as the gesture of a template. The thresholds
+  are computed by tools/template_builder.cpp from how far the recordings of each gesture are from its template (see
+  gesture_thresholds in gesture_tables.h). They also bound the DTW of the template: once it goes over the threshold, it
+  can be abandoned even if no other template has matched yet.
+*/
+inline dtw_cost_t template_threshold(uint8_t t) {
+#if DTW_REJECT && defined(GESTURE_TABLES_LEN)
+  dtw_cost_t threshold;
+  memcpy_P(&threshold, &gesture_thresholds[t], sizeof(threshold));
+  return threshold;
+#else
+  (void) t;
+  return DTW_INFINITY;
+#endif
+}
+
+/// @brief Returns the bound a template has to be matched under, the best distance so far or its threshold if lower
+inline dtw_cost_t template_bound(uint8_t t, dtw_cost_t best) {
+  return min(best, template_threshold(t));
+}
+
+/// @brief Returns the distance of a template, or DTW_INFINITY if it is over the threshold of the template
+inline dtw_cost_t template_accept(uint8_t t, dtw_cost_t distance) {
+  return (distance > template_threshold(t)) ? DTW_INFINITY : distance;
+}
+
+#ifdef GESTURE_TABLES_LEN
+static_assert(GESTURE_TABLES_LEN == collecter_size && GESTURE_TABLES_WINDOW == DTW_WINDOW && GESTURE_TABLES_RADIUS == dtw_radius &&
+              GESTURE_TABLES_COARSE_LEN == dtw_coarse_size &&
+              // Only the thresholds depend on the kernel and the cost, and they are only read by DTW_REJECT
+              ((GESTURE_TABLES_KERNEL == DTW_KERNEL && (GESTURE_TABLES_COST == DTW_COST || DTW_KERNEL == DTW_KERNEL_FLOAT)) ||
+               !DTW_REJECT) &&
+              GESTURE_TABLES_SAX_SEGMENTS == DTW_SAX_SEGMENTS && GESTURE_TABLES_SAX_ALPHABET == DTW_SAX_ALPHABET &&
+              GESTURE_TABLES_PACKED == DTW_PACKED_TEMPLATES,
+              "gesture_tables.h is out of date, rerun tools/template_builder.cpp");
+#else
+static_assert(!DTW_PACKED_TEMPLATES, "DTW_PACKED_TEMPLATES reads the packed templates of gesture_tables.h");
+#endif
+
+/*
+  Streams the samples of a recording out of the flash one after the other. With DTW_PACKED_TEMPLATES, the templates are
+  stored packed in gesture_tables.h, where every axis of every sample is a signed byte, and each sample is decoded on the
+  fly as base + code * scale using the per-template, per-axis base and scale held in its descriptor. That takes half the flash
+  of the raw recordings, and a byte is read from the flash in one instruction instead of two, which pays for the decoding.
+*/
+class GestureReader {
+    private:
+#if DTW_PACKED_TEMPLATES
+    const int8_t* data;
+    int16_t base[3];
+    uint8_t scale[3];
+#else
+    const int16_t* data;
+#endif
+
+    public:
+
+    /// @brief Starts reading a recording from one of its samples
+    /// @param t the index of the template in DTW_TEMPLATES
+    /// @param j the index of the first sample to read
+    GestureReader(uint8_t t, uint8_t j) {
+#if DTW_PACKED_TEMPLATES
+        this->data = template_data(t) + j * 3;
+        for (uint8_t k = 0; k < 3; k++) {
+            this->base[k] = (int16_t) pgm_read_word(&DTW_TEMPLATES[t].base[k]);
+            this->scale[k] = pgm_read_byte(&DTW_TEMPLATES[t].scale[k]);
+        }
+#else
+        this->data = template_data(t) + j * 3;
+#endif
+    }
+
+    /// @brief Moves the reader forward by the given number of samples
+    inline void skip(uint8_t samples) {
+        this->data += samples * 3;
+    }
+
+    /// @brief Reads the next sample of the recording
+    inline void next(int16_t& x, int16_t& y, int16_t& z) {
+#if DTW_PACKED_TEMPLATES
+        x = this->base[0] + (int8_t) pgm_read_byte(this->data++) * this->scale[0];
+        y = this->base[1] + (int8_t) pgm_read_byte(this->data++) * this->scale[1];
+        z = this->base[2] + (int8_t) pgm_read_byte(this->data++) * this->scale[2];
+#else
+        x = (int16_t) pgm_read_word(this->data++);
+        y = (int16_t) pgm_read_word(this->data++);
+        z = (int16_t) pgm_read_word(this->data++);
+#endif
+    }
+
+#if DTW_PACKED_TEMPLATES
+    /// @brief Returns the address in the flash of the next sample to read
+    inline const int8_t* position() const {
+        return this->data;
+    }
+
+    /// @brief Returns the base of an axis of the recording
+    inline int16_t axis_base(uint8_t k) const {
+        return this->base[k];
+    }
+
+    /// @brief Returns the scale of an axis of the recording
+    inline uint8_t axis_scale(uint8_t k) const {
+        return this->scale[k];
+    }
+#endif
+};
+
+/*
+  Updates a run of consecutive cells of a row in place, from left to right. This is the inner loop of every DTW kernel.
+  cells[k] is the k-th cell to update, diag is the cell above-left of the first one, and the cell above cells[k] is
+  cells[k + shift]. The cell to the left of the first one is unreachable. The gesture is read from the template sample
+  of the first cell onwards, and where it is left afterwards is unspecified.
+  Returns the cheapest of the updated cells.
+  This is the reference version, dtw_row() can be specialised for a metric (see dtw_asm.h) but has to agree with it.
+*/
+template <class Metric>
+inline typename Metric::cost_t dtw_row_reference(typename Metric::cost_t* cells, uint8_t shift,
+                                                 typename Metric::cost_t diag, uint8_t count, GestureReader& gesture,
+                                                 int16_t qx, int16_t qy, int16_t qz) {
+  typedef typename Metric::cost_t cost_t;
+  cost_t left = Metric::infinity; // The cell to the left
+  cost_t row_min = Metric::infinity;
+  for (uint8_t k = 0; k < count; k++) {
+    int16_t tx, ty, tz;
+    gesture.next(tx, ty, tz);
+    cost_t up = cells[k + shift];
+    left = dtw_add(Metric::match(tx, ty, tz, qx, qy, qz), min(diag, min(up, left)));
+    cells[k] = left;
+    row_min = min(row_min, left);
+    diag = up;
+  }
+  return row_min;
+}
+
+/// @brief Updates a run of consecutive cells of a row in place, see dtw_row_reference()
+template <class Metric>
+inline typename Metric::cost_t dtw_row(typename Metric::cost_t* cells, uint8_t shift, typename Metric::cost_t diag,
+                                       uint8_t count, GestureReader& gesture, int16_t qx, int16_t qy, int16_t qz) {
+  return dtw_row_reference<Metric>(cells, shift, diag, count, gesture, qx, qy, qz);
+}
+
+#ifndef DTW_ASM_OWN
+#define DTW_ASM_OWN 0
+#include "dtw_asm.h"
+#endif
+
+/// @brief Prepares a band before the first query sample is matched
+void dtw_begin(dtw_cost_t* band) {
+  for (uint8_t k = 0; k < dtw_band_size; k++) {
+    band[k] = DTW_INFINITY;
+  }
+  band[dtw_radius + 1] = 0; // The (virtual) cell before the origin, the diagonal of the first cell
+}
+
+/// @brief Rolls a band forward by matching the recording against the query sample i, only over the given template samples
+/// @param band the band of the recording, holding row i - 1
+/// @param t the index of the template in DTW_TEMPLATES
+/// @param i the index of the query sample
+/// @param qx the x acceleration of the query sample
+/// @param qy the y acceleration of the query sample
+/// @param qz the z acceleration of the query sample
+/// @param lo the first template sample to match, has to be inside the window of i and can't decrease from one row to the next
+/// @param hi the last template sample to match, has to be inside the window of i and can't decrease from one row to the next
+/// @return the cheapest cell of row i
+dtw_cost_t dtw_step(dtw_cost_t* band, uint8_t t, uint8_t i, int16_t qx, int16_t qy, int16_t qz, uint8_t lo, uint8_t hi) {
+  if (lo > hi) {
+    // Nothing in this row can be matched, so nothing after it can be reached either
+    for (uint8_t k = 0; k < dtw_band_size; k++) {
+      band[k] = DTW_INFINITY;
+    }
+    return DTW_INFINITY;
+  }
+  const uint8_t m = template_length(t);
+  const uint8_t c = dtw_center(i, m);
+  // How far the diagonal moved since the previous row, the first row starts from the (virtual) cell before the origin
+  const uint8_t shift = (i > 0) ? c - dtw_center(i - 1, m) : 1;
+  dtw_cost_t* row = band + dtw_radius + 1 - c; // row[j] is the cell (i, j)
+  GestureReader gesture(t, lo);
+  // row[lo + shift - 1] still holds the cell (i - 1, lo - 1)
+  dtw_cost_t row_min = dtw_row<DTWMetric>(row + lo, shift, row[lo + shift - 1], hi - lo + 1, gesture, qx, qy, qz);
+  // Cells just outside the matched range have to read as unreachable for the next row
+  row[lo - 1] = DTW_INFINITY;
+  for (dtw_cost_t* k = row + hi + 1; k < band + dtw_band_size; k++) {
+    *k = DTW_INFINITY;
+  }
+  return row_min;
+}
+
+/// @brief Rolls a band forward by matching the recording against the query sample { ax, ay, az } i, only over the given
+/// template samples
+inline dtw_cost_t dtw_step(dtw_cost_t* band, uint8_t t, uint8_t i, const int16_t query_sample[3], uint8_t lo, uint8_t hi) {
+  return dtw_step(band, t, i, query_sample[0], query_sample[1], query_sample[2], lo, hi);
+}
+
+/// @brief Rolls a band forward by matching the recording against the query sample i over the whole window of i
+dtw_cost_t dtw_step(dtw_cost_t* band, uint8_t t, uint8_t i, int16_t qx, int16_t qy, int16_t qz) {
+  uint8_t lo, hi;
+  dtw_window(i, template_length(t), lo, hi);
+  return dtw_step(band, t, i, qx, qy, qz, lo, hi);
+}
+
+/// @brief Rolls a band forward by matching the recording against the query sample { ax, ay, az } i over the whole window of i
+inline dtw_cost_t dtw_step(dtw_cost_t* band, uint8_t t, uint8_t i, const int16_t query_sample[3]) {
+  return dtw_step(band, t, i, query_sample[0], query_sample[1], query_sample[2]);
+}
+
+/// @brief Returns the DTW distance held by a band once the whole query has been matched
+inline dtw_cost_t dtw_distance(const dtw_cost_t* band) {
+  return band[dtw_radius + 1]; // Cell (collecter_size - 1, m - 1), which is on the diagonal
+}
+
+/*
+  Performs the DTW algorithm and returns the computed distance. The Domain Time Warping (DTW) algorithm attempts to find the best mapping
+  between the points of one time series and another. The algorithm calculates all possible mappings at each step, assumes the minimum,
+  and proceeds to do that again with that assumption in mind. The query (the collected data) is walked one sample at a time, and for each
+  sample the band of costs against the template (the recording held in the flash) is rolled forward. Only the cells inside the warping
+  window are visited. By the end of the algorithm, the minimum distance is held in the last cell of the band.
+  Every warping path crosses every row, so once all the cells of a row cost more than the given bound, the final distance will too.
+  At that point the algorithm is abandoned and DTW_INFINITY is returned.
+  This version works with any window and any recording length, goes through dtw_step() for every row, and returns the
+  distance before it is normalised.
+*/
+dtw_cost_t calculate_DTW_generic(uint8_t t, const int16_t query[][3], dtw_cost_t bound = DTW_INFINITY) {
+  dtw_begin(DTW_band);
+  for (uint8_t i = 0; i < collecter_size; i++) {
+    if (dtw_step(DTW_band, t, i, query[i]) > bound) {
+      return DTW_INFINITY;
+    }
+  }
+  return dtw_distance(DTW_band);
+}
+
+/*
+  The same DTW as calculate_DTW_generic(), specialised at compile time for a query and a recording of N samples, a
+  Sakoe-Chiba band of radius R and a cell cost Metric. The band lives on the stack with a constant size, the window bounds are derived from
+  constants, the axes are spelled out, and the header of a packed recording is only read once per recording instead of
+  once per row, after which every row streams the recording out of the flash sequentially.
+*/
+template <uint8_t N, uint8_t R, class Metric>
+typename Metric::cost_t dtw_fixed(uint8_t t, const int16_t query[][3], typename Metric::cost_t bound) {
+  typedef typename Metric::cost_t cost_t;
+  const cost_t infinity = Metric::infinity;
+  cost_t band[2 * R + 4];
+  for (uint8_t k = 0; k < 2 * R + 4; k++) {
+    band[k] = infinity;
+  }
+  band[R + 1] = 0; // The (virtual) cell before the origin
+  const GestureReader start(t, 0);
+  for (uint8_t i = 0; i < N; i++) {
+    const uint8_t lo = (i > R) ? i - R : 0;
+    const uint8_t hi = (i + R < N - 1) ? i + R : N - 1;
+    cost_t* row = band + R + 1 - i; // row[j] is the cell (i, j)
+    const int16_t qx = query[i][0];
+    const int16_t qy = query[i][1];
+    const int16_t qz = query[i][2];
+    GestureReader gesture = start;
+    gesture.skip(lo);
+    // The diagonal moves by one sample per row, so row[lo] still holds the cell (i - 1, lo - 1)
+    cost_t row_min = dtw_row<Metric>(row + lo, 1, row[lo], hi - lo + 1, gesture, qx, qy, qz);
+    if (row_min > bound) {
+      return infinity;
+    }
+    // The band moves by at most one sample per row, so only the cells right next to it have to be cleared
+    row[lo - 1] = infinity;
+    row[hi + 1] = infinity;
+  }
+  return band[R + 1];
+}
+
+/*
+  Performs the DTW algorithm between a recording and the query, and returns the normalised distance, or DTW_INFINITY if it
+  was abandoned because it could not get under the normalised bound (see calculate_DTW_generic()).
+*/
+dtw_cost_t calculate_DTW(uint8_t t, const int16_t query[][3], dtw_cost_t bound = DTW_INFINITY) {
+  const uint8_t m = template_length(t);
+  bound = dtw_denormalise(bound, m);
+#if DTW_SPECIALISED_KERNEL && DTW_WINDOW != DTW_WINDOW_ITAKURA
+  if (m == collecter_size) {
+    return dtw_normalise(dtw_fixed<collecter_size, dtw_radius, DTWMetric>(t, query, bound), m);
+  }
+#endif
+  return dtw_normalise(calculate_DTW_generic(t, query, bound), m);
+}
+
+#if DTW_STREAMING || DTW_INTERLEAVED
+/*
+  Streaming DTW: instead of waiting for the whole query before running the DTW, every recording keeps its own band, and all
+  the bands are rolled forward by one query sample as soon as that sample is collected. The work is spread over the active
+  window, and the distances are ready by the time the last sample arrives. This holds one band per recording in RAM, so it
+  is meant to be used with a narrow window (with the default radius of 4 and the L1 cost, the 10 centroids take 480 bytes). The bands are
+  laid out one after the other, and each query sample is only read once for all of them.
+*/
+dtw_cost_t DTW_stream_bands[dtw_num_templates][dtw_band_size];
+
+/// @brief The cheapest cell of the last row of each band, the cost of the best match of the query so far
+dtw_cost_t DTW_stream_row_min[dtw_num_templates];
+
+/// @brief Matches every recording against the query sample i that was just collected
+void dtw_stream_step(uint8_t i, const int16_t query_sample[3]) {
+  const int16_t qx = query_sample[0];
+  const int16_t qy = query_sample[1];
+  const int16_t qz = query_sample[2];
+  dtw_cost_t* band = DTW_stream_bands[0];
+  for (uint8_t t = 0; t < dtw_num_templates; t++) {
+    if (i == 0) {
+      dtw_begin(band);
+    }
+    DTW_stream_row_min[t] = dtw_step(band, t, i, qx, qy, qz);
+    band += dtw_band_size;
+  }
+}
+
+/*
+  Early classification: after the query sample i has been streamed, the cheapest cell of the last row of a band is the
+  cost of matching the query so far against the part of the recording it has reached. Normalised like the distances, these
+  partial costs are compared across the recordings, and once DTW_EARLY_MIN_SAMPLES have been collected, if every recording
+  of another gesture costs at least DTW_EARLY_MARGIN percent more than the closest one, the rest of the window can't
+  realistically change the outcome and the closest recording is chosen right away. The partial cost only grows with the
+  rest of the window, so a recording whose partial cost is already over its threshold can't be chosen early.
+  Returns whether the decision was taken, in which case chosen is set to the index of the recording in DTW_TEMPLATES.
+*/
+bool dtw_early_decision(uint8_t i, uint8_t& chosen) {
+  if (i + 1 < DTW_EARLY_MIN_SAMPLES) {
+    return false;
+  }
+  dtw_cost_t best = DTW_INFINITY;
+  dtw_cost_t runner_up = DTW_INFINITY; // The cheapest recording of any other gesture
+  uint8_t best_t = 0;
+  for (uint8_t t = 0; t < dtw_num_templates; t++) {
+    dtw_cost_t curr = dtw_normalise(DTW_stream_row_min[t], template_length(t));
+    if (curr < best) {
+      if (template_label(t) != template_label(best_t)) {
+        runner_up = best;
+      }
+      best = curr;
+      best_t = t;
+    }
+    else if (curr < runner_up && template_label(t) != template_label(best_t)) {
+      runner_up = curr;
+    }
+  }
+  // In floating point so that the comparison can't overflow whatever the cost type
+  if (best > template_threshold(best_t) || (float) runner_up * 100 < (float) best * (100 + DTW_EARLY_MARGIN)) {
+    return false;
+  }
+  chosen = best_t;
+  return true;
+}
+
+/// @brief Returns the normalised DTW distance of a recording once the whole query has been streamed
+inline dtw_cost_t dtw_stream_distance(uint8_t t) {
+  return dtw_normalise(dtw_distance(DTW_stream_bands[t]), template_length(t));
+}
+
+/*
+  Interleaved classification: the already collected query is swept once, and every sample advances the bands of all the
+  templates together, like the streaming DTW does while collecting. The query is read once in total instead of once per
+  template. There is no best distance to abandon against until the sweep is over, so every template runs to the end, which
+  makes it a better fit when the work has to be done per query sample rather than per template.
+  Returns the index of the chosen template, or dtw_unknown if every template was rejected.
+*/
+uint8_t classify_interleaved(const int16_t query[][3], dtw_cost_t& distance) {
+  for (uint8_t i = 0; i < collecter_size; i++) {
+    dtw_stream_step(i, query[i]);
+  }
+  uint8_t chosen = dtw_unknown;
+  distance = DTW_INFINITY;
+  for (uint8_t t = 0; t < dtw_num_templates; t++) {
+    dtw_cost_t curr = template_accept(t, dtw_stream_distance(t));
+    if (curr < distance) {
+      distance = curr;
+      chosen = t;
+    }
+  }
+  return chosen;
+}
+#endif
+
+/*
+  LB_Kim lower bound: every warping path starts by matching the first samples together and ends by matching the last
+  samples together, so the cost of those two cells can never be more than the DTW distance. The bound is normalised like
+  the distance.
+*/
+dtw_cost_t lb_kim(uint8_t t, const int16_t query[][3]) {
+  const uint8_t m = template_length(t);
+  const int16_t* q_last = query[collecter_size - 1];
+  int16_t x, y, z;
+  GestureReader first(t, 0);
+  first.next(x, y, z);
+  dtw_cost_t first_cost = dtw_cell_cost(x, y, z, query[0][0], query[0][1], query[0][2]);
+  GestureReader last(t, m - 1);
+  last.next(x, y, z);
+  dtw_cost_t last_cost = dtw_cell_cost(x, y, z, q_last[0], q_last[1], q_last[2]);
+  return dtw_normalise(dtw_add(first_cost, last_cost), m);
+}
+
+/// @brief Returns how far a value lies outside of the [lower, upper] range, or 0 if it is inside
+inline int16_t dtw_outside(int16_t value, int16_t lower, int16_t upper) {
+  if (value > upper) {
+    return value - upper;
+  }
+  if (value < lower) {
+    return lower - value;
+  }
+  return 0;
+}
+
+#ifdef GESTURE_TABLES_LEN
+/*
+  LB_Keogh lower bound: the envelope of a recording holds, for each query sample, the per-axis maximum and minimum of the
+  recording over the warping window of that sample (see gesture_tables.h). Each query sample has to be matched against at
+  least one recording sample inside its window, which can't be closer than the envelope is, so summing the distances
+  from the query to the envelope never exceeds the DTW distance. The sum stops as soon as it goes over the bound. Both the
+  bound and the result are normalised like the distance.
+*/
+dtw_cost_t lb_keogh(uint8_t t, const int16_t query[][3], dtw_cost_t bound = DTW_INFINITY) {
+  const uint8_t m = template_length(t);
+  const int16_t* envelope = (const int16_t*) pgm_read_ptr(&gesture_envelopes[t]);
+  bound = dtw_denormalise(bound, m);
+  dtw_cost_t res = 0;
+  for (uint8_t i = 0; i < collecter_size && res <= bound; i++) {
+    // Each envelope entry holds { upper x, upper y, upper z, lower x, lower y, lower z }
+    int16_t dx = dtw_outside(query[i][0], (int16_t) pgm_read_word(envelope + 3), (int16_t) pgm_read_word(envelope));
+    int16_t dy = dtw_outside(query[i][1], (int16_t) pgm_read_word(envelope + 4), (int16_t) pgm_read_word(envelope + 1));
+    int16_t dz = dtw_outside(query[i][2], (int16_t) pgm_read_word(envelope + 5), (int16_t) pgm_read_word(envelope + 2));
+    res = dtw_add(res, dtw_axis_cost(dx, dy, dz));
+    envelope += 6;
+  }
+  return dtw_normalise(res, m);
+}
+#endif
+
+/*
+  Piecewise Aggregate Approximation (PAA): shrinks a series of src_len samples down to dst_len samples, each holding the
+  average of the consecutive samples of its segment. Segment a covers the samples from dtw_paa_start(a) up to (but not
+  including) dtw_paa_start(a + 1).
+*/
+inline uint8_t dtw_paa_start(uint8_t a, uint8_t src_len, uint8_t dst_len) {
+  return (uint16_t) a * src_len / dst_len;
+}
+
+void dtw_paa(const int16_t src[][3], uint8_t src_len, int16_t dst[][3], uint8_t dst_len) {
+  for (uint8_t a = 0; a < dst_len; a++) {
+    uint8_t start = dtw_paa_start(a, src_len, dst_len);
+    uint8_t end = dtw_paa_start(a + 1, src_len, dst_len);
+    for (uint8_t k = 0; k < 3; k++) {
+      int32_t sum = 0;
+      for (uint8_t i = start; i < end; i++) {
+        sum += src[i][k];
+      }
+      dst[a][k] = sum / (end - start);
+    }
+  }
+}
+
+/*
+  Summary features of a series, computed in a single pass and compared before any DTW runs. For each axis:
+  - the mean, the minimum and the maximum
+  - the energy, as the mean absolute deviation from the mean, which stays in the units of the samples
+  - the zero crossings once the mean is removed (gravity keeps most axes on one side of zero otherwise), counted per
+    collecter_size samples so that series of different lengths can be compared
+  The features are laid out as { mean x, mean y, mean z, min x, ..., energy x, ..., crossings x, ... }.
+*/
+const uint8_t dtw_num_features = 15;
+
+void dtw_features(const int16_t series[][3], uint8_t len, int16_t features[dtw_num_features]) {
+  for (uint8_t k = 0; k < 3; k++) {
+    int32_t sum = 0;
+    int16_t lo = series[0][k];
+    int16_t hi = series[0][k];
+    for (uint8_t i = 0; i < len; i++) {
+      sum += series[i][k];
+      lo = min(lo, series[i][k]);
+      hi = max(hi, series[i][k]);
+    }
+    const int16_t mean = sum / len;
+    int32_t deviation = 0;
+    uint8_t crossings = 0;
+    for (uint8_t i = 0; i < len; i++) {
+      deviation += abs(series[i][k] - mean);
+      if (i > 0 && (series[i][k] >= mean) != (series[i - 1][k] >= mean)) {
+        crossings++;
+      }
+    }
+    features[k] = mean;
+    features[3 + k] = lo;
+    features[6 + k] = hi;
+    features[9 + k] = deviation / len;
+    features[12 + k] = (uint16_t) crossings * collecter_size / len;
+  }
+}
+
+/*
+  Symbolic Aggregate approXimation (SAX): a series is averaged down to DTW_SAX_SEGMENTS segments per axis (PAA), and each
+  average is replaced by the symbol of the cell it falls in, out of DTW_SAX_ALPHABET cells split by DTW_SAX_ALPHABET - 1
+  breakpoints per axis. Symbol s covers [breakpoints[s - 1], breakpoints[s]), the first and last cells are open-ended.
+  The breakpoints are read through pgm_read_word() so that they can be in the flash.
+*/
+inline uint8_t dtw_sax_symbol(int16_t value, const int16_t* breakpoints) {
+  uint8_t symbol = 0;
+  while (symbol < DTW_SAX_ALPHABET - 1 && value >= (int16_t) pgm_read_word(breakpoints + symbol)) {
+    symbol++;
+  }
+  return symbol;
+}
+
+#ifdef GESTURE_TABLES_LEN
+/// @brief Returns the weighted L1 distance between the features of the query and those of a template (see gesture_tables.h)
+uint32_t dtw_feature_distance(const int16_t query_features[dtw_num_features], uint8_t t) {
+  uint32_t res = 0;
+  for (uint8_t f = 0; f < dtw_num_features; f++) {
+    uint16_t diff = abs((int32_t) query_features[f] - (int16_t) pgm_read_word(&gesture_features[t][f]));
+    res += (f < 12) ? diff : (uint32_t) diff * DTW_CROSSING_WEIGHT;
+  }
+  return res;
+}
+
+/// @brief Encodes the query into its SAX word, one symbol per segment and axis
+void dtw_sax_encode(const int16_t query[][3], uint8_t word[DTW_SAX_SEGMENTS][3]) {
+  int16_t averages[DTW_SAX_SEGMENTS][3];
+  dtw_paa(query, collecter_size, averages, DTW_SAX_SEGMENTS);
+  for (uint8_t s = 0; s < DTW_SAX_SEGMENTS; s++) {
+    for (uint8_t k = 0; k < 3; k++) {
+      word[s][k] = dtw_sax_symbol(averages[s][k], gesture_sax_breakpoints[k]);
+    }
+  }
+}
+
+/// @brief Returns how far apart the cell of a query symbol and the cells from lo to hi of a template are
+inline int16_t dtw_sax_gap(uint8_t symbol, uint8_t lo, uint8_t hi, const int16_t* breakpoints) {
+  if (symbol < lo) {
+    return (int16_t) pgm_read_word(breakpoints + lo - 1) - (int16_t) pgm_read_word(breakpoints + symbol);
+  }
+  if (symbol > hi) {
+    return (int16_t) pgm_read_word(breakpoints + symbol - 1) - (int16_t) pgm_read_word(breakpoints + hi);
+  }
+  return 0;
+}
+
+/*
+  MINDIST between the word of the query and the word of a bucket of the SAX index, a lower bound of the DTW distance (before
+  it is normalised) of every template in the bucket. A template's word holds, for each segment and axis, the range of
+  symbols covered by its LB_Keogh envelope over the query samples of the segment (see gesture_tables.h). Every query sample
+  costs at least its distance to that envelope, and since that distance is convex, the samples of a segment together cost
+  at least as many times the distance of their average, which is itself no closer than the gap between the cells.
+*/
+dtw_cost_t dtw_mindist(const uint8_t word[DTW_SAX_SEGMENTS][3], uint8_t bucket) {
+  const uint8_t* ranges = gesture_sax_words[bucket];
+  dtw_cost_t res = 0;
+  for (uint8_t s = 0; s < DTW_SAX_SEGMENTS; s++) {
+    int16_t gaps[3];
+    for (uint8_t k = 0; k < 3; k++) {
+      // Each range is packed as lo | hi << 4
+      uint8_t range = pgm_read_byte(ranges++);
+      gaps[k] = dtw_sax_gap(word[s][k], range & 0x0F, range >> 4, gesture_sax_breakpoints[k]);
+    }
+    dtw_cost_t cost = dtw_axis_cost(gaps[0], gaps[1], gaps[2]);
+    for (uint8_t i = dtw_paa_start(s, collecter_size, DTW_SAX_SEGMENTS); i < dtw_paa_start(s + 1, collecter_size, DTW_SAX_SEGMENTS); i++) {
+      res = dtw_add(res, cost);
+    }
+  }
+  return res;
+}
+
+/*
+  Picks the templates worth running the DTW on. With DTW_SAX_INDEX, the templates are grouped into buckets by their SAX
+  words (see gesture_tables.h), and the query is encoded into its own word. The buckets whose MINDIST to the query already
+  puts a template over its threshold are dropped without reading the template, and the remaining templates are sorted by
+  MINDIST so that the most promising ones set a tight bound for the others. Only the word of each bucket is read, so the
+  cost of the lookup grows with the number of distinct words rather than with the number of recordings. With DTW_SHORTLIST, the features of the query are compared against the
+  features of every template, which only takes a pass over the query and a few operations per template, and only the
+  DTW_SHORTLIST closest templates are kept, the closest first so that it gives the tightest bound to the ones after it.
+  Gestures that move the board over very different ranges (a wipe against a circle) are told apart by the features alone.
+  Without DTW_SHORTLIST every template is kept, in order.
+  Returns how many templates were written to candidates.
+*/
+uint8_t dtw_candidates(const int16_t query[][3], uint8_t candidates[dtw_num_templates]) {
+#if DTW_SAX_INDEX
+  uint8_t word[DTW_SAX_SEGMENTS][3];
+  dtw_sax_encode(query, word);
+  dtw_cost_t bounds[dtw_num_templates];
+  uint8_t num_candidates = 0;
+  const uint8_t num_buckets = sizeof(gesture_sax_bucket_starts) - 1;
+  for (uint8_t b = 0; b < num_buckets; b++) {
+    const dtw_cost_t mindist = dtw_mindist(word, b);
+    const uint8_t end = pgm_read_byte(&gesture_sax_bucket_starts[b + 1]);
+    for (uint8_t e = pgm_read_byte(&gesture_sax_bucket_starts[b]); e < end; e++) {
+      const uint8_t t = pgm_read_byte(&gesture_sax_members[e]);
+      const dtw_cost_t bound = dtw_normalise(mindist, template_length(t));
+      if (bound > template_threshold(t)) {
+        continue;
+      }
+      // Inserted in order of their lower bounds
+      uint8_t k = num_candidates++;
+      while (k > 0 && bounds[k - 1] > bound) {
+        candidates[k] = candidates[k - 1];
+        bounds[k] = bounds[k - 1];
+        k--;
+      }
+      candidates[k] = t;
+      bounds[k] = bound;
+    }
+  }
+  return num_candidates;
+#elif DTW_SHORTLIST
+  int16_t features[dtw_num_features];
+  dtw_features(query, collecter_size, features);
+  uint32_t distances[DTW_SHORTLIST];
+  uint8_t num_candidates = 0;
+  for (uint8_t t = 0; t < dtw_num_templates; t++) {
+    uint32_t distance = dtw_feature_distance(features, t);
+    uint8_t k = (num_candidates < DTW_SHORTLIST) ? num_candidates++ : DTW_SHORTLIST;
+    while (k > 0 && distances[k - 1] > distance) {
+      if (k < DTW_SHORTLIST) {
+        candidates[k] = candidates[k - 1];
+        distances[k] = distances[k - 1];
+      }
+      k--;
+    }
+    if (k < DTW_SHORTLIST) {
+      candidates[k] = t;
+      distances[k] = distance;
+    }
+  }
+  return num_candidates;
+#else
+  (void) query;
+  for (uint8_t t = 0; t < dtw_num_templates; t++) {
+    candidates[t] = t;
+  }
+  return dtw_num_templates;
+#endif
+}
+
+/*
+  Classifies the query with the cascade: the candidates of dtw_candidates() are matched in order, the cheap lower bounds
+  first, and only the templates that could still beat the best distance so far (or pass their threshold) reach the DTW,
+  with that distance as the bound so that they are abandoned as soon as they can't. With DTW_STREAMING, the distances
+  were already computed while the query was being collected, and are only read.
+  Returns the index of the chosen template, or dtw_unknown if every candidate was rejected.
+*/
+uint8_t classify_cascade(const int16_t query[][3], dtw_cost_t& distance) {
+  uint8_t candidates[dtw_num_templates];
+  const uint8_t num_candidates = dtw_candidates(query, candidates);
+  uint8_t chosen = dtw_unknown;
+  distance = DTW_INFINITY;
+  for (uint8_t k = 0; k < num_candidates; k++) {
+    const uint8_t t = candidates[k];
+#if DTW_STREAMING
+    dtw_cost_t curr = template_accept(t, dtw_stream_distance(t));
+#else
+    dtw_cost_t curr = DTW_INFINITY;
+    const dtw_cost_t bound = template_bound(t, distance);
+    if (lb_kim(t, query) <= bound && lb_keogh(t, query, bound) <= bound) {
+      curr = template_accept(t, calculate_DTW(t, query, bound));
+    }
+#endif
+    if (curr < distance) {
+      distance = curr;
+      chosen = t;
+    }
+  }
+  return chosen;
+}
+#endif
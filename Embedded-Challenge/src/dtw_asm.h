@@ -0,0 +1,152 @@
+/*
+    AVR assembly for the inner loop of the DTW, the update of a run of cells of a row with the L1 cost on the packed
+    recordings (see dtw_row_reference() in dtw.h, which it has to agree with). Per cell:
+    - the three packed codes are streamed from the flash with LPM Z+, and each is expanded with the hardware MULSU
+      into code * scale + (base - q), which is the difference between the template and the query samples on that axis
+    - the absolute differences are summed into the cost without widening anything past 16 bits
+    - the diagonal and the left neighbour stay in registers, only the cell above is loaded and the new cell stored, into
+      the register of the diagonal since it is the diagonal of the next cell
+    About 73 cycles per cell against about 200 for the compiled reference. The loop keeps 23 registers besides r0 and r1,
+    X and Z included, four of them in r16 to r23 for MULSU.
+
+    It is experimental, and only used when DTW_ASM_KERNEL is set on an AVR, with DTW_PACKED_TEMPLATES and the narrow L1
+    integer kernel (DTW_COST_NARROW_L1), since its costs are 16 bits wide. test/test_embedded_dtw_asm compares it with the
+    reference under simavr, on random rows and on rows that saturate. The benchmark (dtw_benchmark.h) also checks it
+    against the reference on every row of every template before timing it.
+
+    This file is included by dtw.h.
+*/
+
+#ifdef __has_include
+    #if __has_include(<Arduino.h>)
+        #include <Arduino.h>
+    #endif
+#endif
+
+#if DTW_ASM_KERNEL && DTW_PACKED_TEMPLATES && DTW_KERNEL == DTW_KERNEL_INT && DTW_COST == DTW_COST_NARROW_L1 && defined(__AVR__)
+#define DTW_ASM_ROW 1 // dtw_row<NarrowL1Metric>() is replaced
+
+/*
+  Updates count (at least 1) cells from cells onwards, where the cell above cells[k] is cells[k + S], reading the packed
+  codes from the flash at codes. offset[k] is the base of the axis minus the query sample on that axis.
+  Returns the cheapest of the updated cells.
+*/
+template <uint8_t S>
+inline uint16_t dtw_row_asm(uint16_t* cells, uint16_t diag, uint8_t count, const int8_t* codes,
+                            const int16_t offset[3], const uint8_t scale[3]) {
+  uint16_t left = UINT16_MAX;
+  uint16_t row_min = UINT16_MAX;
+  uint16_t cost;
+  uint8_t code;
+  asm volatile(
+    "1:"                                 "\n\t"
+    "clr %A[cost]"                       "\n\t"
+    "clr %B[cost]"                       "\n\t"
+    // X axis: r1:r0 = code * scale + offset, then cost += |r1:r0|
+    "lpm %[code], Z+"                    "\n\t"
+    "mulsu %[code], %[sx]"               "\n\t"
+    "add r0, %A[ox]"                     "\n\t"
+    "adc r1, %B[ox]"                     "\n\t"
+    "sbrc r1, 7"                         "\n\t"
+    "rjmp 2f"                            "\n\t"
+    "add %A[cost], r0"                   "\n\t"
+    "adc %B[cost], r1"                   "\n\t"
+    "rjmp 3f"                            "\n\t"
+    "2:"                                 "\n\t"
+    "sub %A[cost], r0"                   "\n\t"
+    "sbc %B[cost], r1"                   "\n\t"
+    "3:"                                 "\n\t"
+    // Y axis
+    "lpm %[code], Z+"                    "\n\t"
+    "mulsu %[code], %[sy]"               "\n\t"
+    "add r0, %A[oy]"                     "\n\t"
+    "adc r1, %B[oy]"                     "\n\t"
+    "sbrc r1, 7"                         "\n\t"
+    "rjmp 2f"                            "\n\t"
+    "add %A[cost], r0"                   "\n\t"
+    "adc %B[cost], r1"                   "\n\t"
+    "rjmp 3f"                            "\n\t"
+    "2:"                                 "\n\t"
+    "sub %A[cost], r0"                   "\n\t"
+    "sbc %B[cost], r1"                   "\n\t"
+    "3:"                                 "\n\t"
+    // Z axis
+    "lpm %[code], Z+"                    "\n\t"
+    "mulsu %[code], %[sz]"               "\n\t"
+    "add r0, %A[oz]"                     "\n\t"
+    "adc r1, %B[oz]"                     "\n\t"
+    "sbrc r1, 7"                         "\n\t"
+    "rjmp 2f"                            "\n\t"
+    "add %A[cost], r0"                   "\n\t"
+    "adc %B[cost], r1"                   "\n\t"
+    "rjmp 3f"                            "\n\t"
+    "2:"                                 "\n\t"
+    "sub %A[cost], r0"                   "\n\t"
+    "sbc %B[cost], r1"                   "\n\t"
+    "3:"                                 "\n\t"
+    "clr __zero_reg__"                   "\n\t"
+    // left = min(diag, left)
+    "cp %A[diag], %A[left]"              "\n\t"
+    "cpc %B[diag], %B[left]"             "\n\t"
+    "brsh 4f"                            "\n\t"
+    "movw %A[left], %A[diag]"            "\n\t"
+    "4:"                                 "\n\t"
+    // diag = cells[k + S], the cell above, which is also the diagonal of the next cell. X is left on cells[k]
+    "adiw %A[cells], %[up_offset]"       "\n\t"
+    "ld %A[diag], X+"                    "\n\t"
+    "ld %B[diag], X"                     "\n\t"
+    "sbiw %A[cells], %[up_offset] + 1"   "\n\t"
+    // left = min(up, left)
+    "cp %A[diag], %A[left]"              "\n\t"
+    "cpc %B[diag], %B[left]"             "\n\t"
+    "brsh 5f"                            "\n\t"
+    "movw %A[left], %A[diag]"            "\n\t"
+    "5:"                                 "\n\t"
+    // left += cost, saturating at UINT16_MAX on a carry
+    "add %A[left], %A[cost]"             "\n\t"
+    "adc %B[left], %B[cost]"             "\n\t"
+    "sbc %[code], %[code]"               "\n\t"
+    "or %A[left], %[code]"               "\n\t"
+    "or %B[left], %[code]"               "\n\t"
+    // cells[k] = left, X moves on to cells[k + 1]
+    "st X+, %A[left]"                    "\n\t"
+    "st X+, %B[left]"                    "\n\t"
+    // row_min = min(row_min, left)
+    "cp %A[left], %A[row_min]"           "\n\t"
+    "cpc %B[left], %B[row_min]"          "\n\t"
+    "brsh 6f"                            "\n\t"
+    "movw %A[row_min], %A[left]"         "\n\t"
+    "6:"                                 "\n\t"
+    "dec %[count]"                       "\n\t"
+    "breq 7f"                            "\n\t"
+    "rjmp 1b"                            "\n\t"
+    "7:"                                 "\n\t"
+    : [cells] "+x" (cells), [codes] "+z" (codes), [count] "+r" (count), [diag] "+r" (diag), [left] "+r" (left),
+      [row_min] "+r" (row_min), [cost] "=&r" (cost), [code] "=&a" (code)
+    : [sx] "a" (scale[0]), [sy] "a" (scale[1]), [sz] "a" (scale[2]),
+      [ox] "r" (offset[0]), [oy] "r" (offset[1]), [oz] "r" (offset[2]), [up_offset] "I" (2 * S)
+    : "memory"
+  );
+  return row_min;
+}
+
+/// @brief dtw_row() for the narrow L1 cost, through dtw_row_asm()
+template <>
+inline uint16_t dtw_row<NarrowL1Metric>(uint16_t* cells, uint8_t shift, uint16_t diag, uint8_t count,
+                                        GestureReader& gesture, int16_t qx, int16_t qy, int16_t qz) {
+  const int16_t offset[3] = { (int16_t) (gesture.axis_base(0) - qx), (int16_t) (gesture.axis_base(1) - qy),
+                              (int16_t) (gesture.axis_base(2) - qz) };
+  const uint8_t scale[3] = { gesture.axis_scale(0), gesture.axis_scale(1), gesture.axis_scale(2) };
+  const int8_t* codes = gesture.position();
+  // The diagonal moves by 0, 1 or 2 samples per row, and the offset of the cell above is built into the instructions
+  switch (shift) {
+    case 0:
+      return dtw_row_asm<0>(cells, diag, count, codes, offset, scale);
+    case 1:
+      return dtw_row_asm<1>(cells, diag, count, codes, offset, scale);
+    default:
+      return dtw_row_asm<2>(cells, diag, count, codes, offset, scale);
+  }
+}
+
+#endif
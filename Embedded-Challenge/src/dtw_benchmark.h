@@ -0,0 +1,121 @@
+/*
+    Benchmark of the DTW kernels, enabled with DTW_BENCHMARK. It runs once at the end of setup(): the first template
+    is used as the query and matched against every template, first with the generic kernel and then with the kernel
+    specialised at compile time (which only handles the templates as long as the query), and the time each of them
+    took is printed over the serial connection along with whether they agreed on every distance.
+    When the assembly row update of dtw_asm.h is in use, every row of every template is also updated by both it and the
+    reference dtw_row_reference(), starting from the same band, and their timings and whether they agreed are printed.
+
+    This file has to be included after dtw.h.
+*/
+
+#ifdef __has_include
+    #if __has_include(<Arduino.h>)
+        #include <Arduino.h>
+    #endif
+#endif
+
+#ifndef DTW_BENCHMARK
+#define DTW_BENCHMARK 0
+#endif
+
+#ifndef DTW_BENCHMARK_ROUNDS
+#define DTW_BENCHMARK_ROUNDS 10 // How many times every template is matched by each kernel
+#endif
+
+#ifdef DTW_ASM_ROW
+/// @brief Runs the assembly and the reference row updates on the same bands for every row of every template
+/// @param query the query to match, as filled by dtw_benchmark()
+void dtw_asm_check(const int16_t query[][3]) {
+  static dtw_cost_t reference_band[dtw_band_size];
+  static dtw_cost_t asm_band[dtw_band_size];
+  uint32_t reference_us = 0;
+  uint32_t asm_us = 0;
+  bool same = true;
+  for (uint8_t t = 0; t < dtw_num_templates; t++) {
+    const uint8_t m = template_length(t);
+    dtw_begin(DTW_band);
+    for (uint8_t i = 0; i < collecter_size; i++) {
+      uint8_t lo, hi;
+      dtw_window(i, m, lo, hi);
+      const uint8_t c = dtw_center(i, m);
+      const uint8_t shift = (i > 0) ? c - dtw_center(i - 1, m) : 1;
+      const uint8_t first = dtw_radius + 1 - c + lo; // Where the cell (i, lo) is in the band
+      const uint8_t count = hi - lo + 1;
+      memcpy(reference_band, DTW_band, sizeof(DTW_band));
+      memcpy(asm_band, DTW_band, sizeof(DTW_band));
+
+      GestureReader reference_reader(t, lo);
+      uint32_t start = micros();
+      dtw_cost_t reference_min = dtw_row_reference<NarrowL1Metric>(reference_band + first, shift,
+                                                                   reference_band[first + shift - 1], count, reference_reader,
+                                                                   query[i][0], query[i][1], query[i][2]);
+      reference_us += micros() - start;
+
+      GestureReader asm_reader(t, lo);
+      start = micros();
+      dtw_cost_t asm_min = dtw_row<NarrowL1Metric>(asm_band + first, shift, asm_band[first + shift - 1], count, asm_reader,
+                                                   query[i][0], query[i][1], query[i][2]);
+      asm_us += micros() - start;
+
+      same &= asm_min == reference_min && memcmp(reference_band, asm_band, sizeof(DTW_band)) == 0;
+      dtw_step(DTW_band, t, i, query[i]);
+    }
+  }
+  Serial.print(F("Reference rows: "));
+  Serial.print(reference_us);
+  Serial.println(F(" us"));
+  Serial.print(F("Assembly rows: "));
+  Serial.print(asm_us);
+  Serial.println(F(" us"));
+  Serial.println(same ? F("Same rows") : F("Different rows!"));
+}
+#endif
+
+/// @brief Times both DTW kernels over all the templates and prints the results
+/// @param query a buffer of collecter_size samples, overwritten with the first template
+void dtw_benchmark(int16_t query[][3]) {
+  GestureReader reader(0, 0);
+  for (uint8_t i = 0; i < collecter_size; i++) {
+    if (i < template_length(0)) {
+      reader.next(query[i][0], query[i][1], query[i][2]);
+    }
+    else {
+      // A shorter template is padded with its last sample
+      query[i][0] = query[i - 1][0];
+      query[i][1] = query[i - 1][1];
+      query[i][2] = query[i - 1][2];
+    }
+  }
+
+  dtw_cost_t generic_res[dtw_num_templates];
+  uint32_t start = micros();
+  for (uint8_t round = 0; round < DTW_BENCHMARK_ROUNDS; round++) {
+    for (uint8_t t = 0; t < dtw_num_templates; t++) {
+      generic_res[t] = calculate_DTW_generic(t, query);
+    }
+  }
+  uint32_t generic_us = micros() - start;
+
+  bool same = true;
+  start = micros();
+  for (uint8_t round = 0; round < DTW_BENCHMARK_ROUNDS; round++) {
+    for (uint8_t t = 0; t < dtw_num_templates; t++) {
+      if (template_length(t) == collecter_size) {
+        same &= dtw_fixed<collecter_size, dtw_radius, DTWMetric>(t, query, DTW_INFINITY) == generic_res[t];
+      }
+    }
+  }
+  uint32_t fixed_us = micros() - start;
+
+  Serial.print(F("Generic DTW: "));
+  Serial.print(generic_us / DTW_BENCHMARK_ROUNDS);
+  Serial.println(F(" us per classification"));
+  Serial.print(F("Specialised DTW: "));
+  Serial.print(fixed_us / DTW_BENCHMARK_ROUNDS);
+  Serial.println(F(" us per classification"));
+  Serial.println(same ? F("Same distances") : F("Different distances!"));
+#ifdef DTW_ASM_ROW
+  dtw_asm_check(query);
+#endif
+}
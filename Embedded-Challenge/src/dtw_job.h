@@ -0,0 +1,137 @@
+/*
+    Time-sliced classification. Instead of matching the query against every template in a single pass of loop(), which
+    keeps the buttons and the LEDs frozen for as long as the DTWs take, the classification is held in a DTWJob that
+    advances one row of the band at a time and remembers where it stopped. Every pass of loop() gives it a slice of
+    DTW_SLICE_CYCLES CPU cycles, after which loop() gets control back and the job resumes on the next pass. A row is at
+    most 2 * dtw_radius + 1 cells, so a slice never overshoots its budget by more than one row (or one lower bound).
+
+    The job runs the same cascade as the single pass classifier, over the same candidates (see dtw_candidates): LB_Kim and
+    LB_Keogh first, then the DTW with the best distance so far (or the threshold of the template, if lower) as the bound,
+    so it picks the same template with the same distance, or rejects the query as unknown just the same.
+
+    This file has to be included after dtw.h.
+*/
+
+#ifdef __has_include
+    #if __has_include(<Arduino.h>)
+        #include <Arduino.h>
+    #endif
+#endif
+
+/*
+  Whether the 'p' state runs the classification in slices of DTW_SLICE_CYCLES cycles instead of all at once. Off by
+  default: the job goes through the generic dtw_step(), so it doesn't get the kernel specialised for the query length
+  (see dtw_fixed) that the single pass classifier uses.
+*/
+#ifndef DTW_TIME_SLICED
+#define DTW_TIME_SLICED 0
+#endif
+#ifndef DTW_SLICE_CYCLES
+#define DTW_SLICE_CYCLES 16000 // 2 ms at 8 MHz
+#endif
+
+const uint16_t dtw_slice_us = DTW_SLICE_CYCLES / (F_CPU / 1000000L);
+
+class DTWJob {
+    private:
+    const int16_t (*query)[3];
+    uint8_t candidates[dtw_num_templates]; // The templates to match, in order
+    uint8_t num_candidates;
+    uint8_t k; // The candidate being matched
+    uint8_t t; // The template being matched
+    uint8_t i; // The next query sample to match it against, 0 if it hasn't been started yet
+    dtw_cost_t bound; // The best distance so far or the threshold of the template, in the units of the template being matched
+    dtw_cost_t best; // The best normalised distance so far
+    uint8_t chosen; // The template with the best distance so far
+
+    /// @brief Moves on to the next template
+    inline void next_template() {
+        this->k++;
+        if (this->k < this->num_candidates) {
+            this->t = this->candidates[this->k];
+        }
+        this->i = 0;
+    }
+
+    public:
+
+    /// @brief Starts a new classification, the query has to stay untouched until the job is done
+    /// @param query the collected data
+    void begin(const int16_t query[][3]) {
+        this->query = query;
+        this->num_candidates = dtw_candidates(query, this->candidates);
+        this->k = 0;
+        this->t = this->candidates[0];
+        this->i = 0;
+        this->best = DTW_INFINITY;
+        this->chosen = dtw_unknown;
+    }
+
+    /// @brief Returns whether every template has been matched
+    inline bool done() const {
+        return this->k >= this->num_candidates;
+    }
+
+    /// @brief Does the next bounded piece of work: the lower bounds of a template, or one row of its band
+    void step() {
+        const uint8_t m = template_length(this->t);
+        if (this->i == 0) {
+            const dtw_cost_t bound = template_bound(this->t, this->best);
+            if (lb_kim(this->t, this->query) > bound || lb_keogh(this->t, this->query, bound) > bound) {
+                this->next_template();
+                return;
+            }
+            this->bound = dtw_denormalise(bound, m);
+            dtw_begin(DTW_band);
+        }
+        if (dtw_step(DTW_band, this->t, this->i, this->query[this->i]) > this->bound) {
+            this->next_template(); // Abandoned, it can't beat the best distance or pass its threshold anymore
+            return;
+        }
+        this->i++;
+        if (this->i == collecter_size) {
+            dtw_cost_t distance = template_accept(this->t, dtw_normalise(dtw_distance(DTW_band), m));
+            if (distance < this->best) {
+                this->best = distance;
+                this->chosen = this->t;
+            }
+            this->next_template();
+        }
+    }
+
+    /// @brief Advances the classification for about the given time
+    /// @param budget_us how long the slice may last, in microseconds
+    /// @return whether the classification is done
+    bool run(uint16_t budget_us) {
+        uint32_t start = micros();
+        while (!this->done()) {
+            this->step();
+            if (micros() - start >= budget_us) {
+                break;
+            }
+        }
+        return this->done();
+    }
+
+    /// @brief Returns how many templates have been matched so far
+    inline uint8_t progress() const {
+        return this->k;
+    }
+
+    /// @brief Returns how many templates are matched in total
+    inline uint8_t size() const {
+        return this->num_candidates;
+    }
+
+    /// @brief Returns the index of the chosen template, or dtw_unknown if every template was rejected, once the job is done
+    inline uint8_t result() const {
+        return this->chosen;
+    }
+
+    /// @brief Returns the normalised distance of the chosen template, once the job is done
+    inline dtw_cost_t distance() const {
+        return this->best;
+    }
+};
+
+DTWJob DTW_job;
@@ -0,0 +1,226 @@
+/*
+    Coarse-to-fine (FastDTW-style) classification. The query is first averaged down by DTW_MULTIRES_FACTOR (PAA) and
+    compared against the recordings averaged down to the same length, held in gesture_tables.h. At that resolution only
+    the DTW window scaled down by DTW_MULTIRES_FACTOR is visited, whatever the length of the recording. Only the
+    DTW_MULTIRES_CANDIDATES closest recordings are then refined at the full resolution, and only over a corridor of
+    DTW_MULTIRES_RADIUS samples around their coarse warping paths, kept from the coarse pass, projected back onto the full
+    resolution matrix. The cost of the refinement then grows with the length of the
+    gesture rather than with its square, which keeps higher sample rates usable. With the defaults, against the recordings
+    stretched by 0.8 to 1.2 times and with noise added, about 660 cells are visited per query (440 coarse, 220 refined),
+    against about 1000 for the single pass classifier with its lower bounds.
+
+    This file has to be included after dtw.h and gesture_tables.h.
+*/
+
+#ifdef __has_include
+    #if __has_include(<Arduino.h>)
+        #include <Arduino.h>
+    #endif
+#endif
+
+/*
+  How far from its diagonal the coarse DTW matrix is visited: the DTW window scaled down to the coarse resolution,
+  rounded up so that the coarse path can still reach every block the fine window overlaps.
+*/
+const uint8_t dtw_coarse_radius = min((dtw_radius + DTW_MULTIRES_FACTOR - 1) / DTW_MULTIRES_FACTOR, dtw_coarse_size - 1);
+
+/// @brief The query averaged down to the coarse resolution
+int16_t DTW_coarse_query[dtw_coarse_size][3];
+
+/*
+  The band of the DTW matrix at the coarse resolution, kept so that the warping path can be traced back.
+  DTW_coarse_matrix[a][b - a + dtw_coarse_radius] is the coarse cell (a, b).
+*/
+dtw_cost_t DTW_coarse_matrix[dtw_coarse_size][2 * dtw_coarse_radius + 1];
+
+/*
+  The coarse warping paths of the candidates, traced as soon as a recording becomes a candidate so that its coarse DTW
+  doesn't have to be computed again. The path crosses the coarse row a from the template sample DTW_coarse_path_lo[a] to
+  DTW_coarse_path_hi[a].
+*/
+uint8_t DTW_coarse_path_lo[DTW_MULTIRES_CANDIDATES][dtw_coarse_size];
+uint8_t DTW_coarse_path_hi[DTW_MULTIRES_CANDIDATES][dtw_coarse_size];
+
+/// @brief The range of template samples that each query sample is matched against during the refinement
+uint8_t DTW_corridor_lo[collecter_size];
+uint8_t DTW_corridor_hi[collecter_size];
+
+/// @brief Returns the coarse cell (a, b), or DTW_INFINITY if it is outside the coarse band
+inline dtw_cost_t dtw_coarse_cell(uint8_t a, uint8_t b) {
+  if (b + dtw_coarse_radius < a || b > a + dtw_coarse_radius) {
+    return DTW_INFINITY;
+  }
+  return DTW_coarse_matrix[a][b + dtw_coarse_radius - a];
+}
+
+/// @brief Fills the band of the coarse DTW matrix for a coarse recording and returns the coarse distance
+dtw_cost_t dtw_coarse(const int16_t* coarse_gesture) {
+  for (uint8_t a = 0; a < dtw_coarse_size; a++) {
+    const uint8_t lo = (a > dtw_coarse_radius) ? a - dtw_coarse_radius : 0;
+    const uint8_t hi = min(a + dtw_coarse_radius, dtw_coarse_size - 1);
+    const int16_t* sample = coarse_gesture + lo * 3;
+    dtw_cost_t* row = DTW_coarse_matrix[a] + dtw_coarse_radius - a; // row[b] is the cell (a, b)
+    for (uint8_t b = lo; b <= hi; b++) {
+      int16_t x = (int16_t) pgm_read_word(sample++);
+      int16_t y = (int16_t) pgm_read_word(sample++);
+      int16_t z = (int16_t) pgm_read_word(sample++);
+      dtw_cost_t prev = 0;
+      if (a > 0 && b > 0) {
+        prev = min(dtw_coarse_cell(a - 1, b - 1), dtw_coarse_cell(a - 1, b));
+        if (b > lo) {
+          prev = min(prev, row[b - 1]);
+        }
+      }
+      else if (a > 0) {
+        prev = dtw_coarse_cell(a - 1, b);
+      }
+      else if (b > 0) {
+        prev = row[b - 1];
+      }
+      row[b] = dtw_add(dtw_cell_cost(x, y, z, DTW_coarse_query[a][0], DTW_coarse_query[a][1], DTW_coarse_query[a][2]), prev);
+    }
+  }
+  return dtw_coarse_cell(dtw_coarse_size - 1, dtw_coarse_size - 1);
+}
+
+/// @brief Traces the warping path back through the coarse DTW matrix filled by dtw_coarse()
+void dtw_coarse_trace(uint8_t path_lo[dtw_coarse_size], uint8_t path_hi[dtw_coarse_size]) {
+  uint8_t a = dtw_coarse_size - 1;
+  uint8_t b = dtw_coarse_size - 1;
+  path_hi[a] = b;
+  while (true) {
+    path_lo[a] = b;
+    if (a == 0 && b == 0) {
+      break;
+    }
+    // Step back to the cheapest predecessor
+    if (a == 0) {
+      b--;
+    }
+    else if (b == 0) {
+      a--;
+      path_hi[a] = b;
+    }
+    else {
+      dtw_cost_t diag = dtw_coarse_cell(a - 1, b - 1);
+      dtw_cost_t up = dtw_coarse_cell(a - 1, b);
+      dtw_cost_t left = dtw_coarse_cell(a, b - 1);
+      if (diag <= up && diag <= left) {
+        a--;
+        b--;
+        path_hi[a] = b;
+      }
+      else if (up <= left) {
+        a--;
+        path_hi[a] = b;
+      }
+      else {
+        b--;
+      }
+    }
+  }
+}
+
+/*
+  Projects every coarse cell of a traced path onto the block of full resolution cells it was averaged from, widened by
+  DTW_MULTIRES_RADIUS. The corridor is then narrowed to the DTW window so that it fits in the band. A row the window
+  leaves empty is clamped to the edge of the window closest to the path, and a row that doesn't reach the next one is
+  widened until it does, so that the refinement always has a path from the first cell to the last.
+*/
+void dtw_corridor(uint8_t m, const uint8_t path_lo[dtw_coarse_size], const uint8_t path_hi[dtw_coarse_size]) {
+  for (uint8_t i = 0; i < collecter_size; i++) {
+    DTW_corridor_lo[i] = m - 1;
+    DTW_corridor_hi[i] = 0;
+  }
+  for (uint8_t a = 0; a < dtw_coarse_size; a++) {
+    // The fine rows and columns that were averaged into the coarse cells the path crosses on row a, widened by the radius
+    uint8_t row_start = dtw_paa_start(a, collecter_size, dtw_coarse_size);
+    uint8_t row_end = dtw_paa_start(a + 1, collecter_size, dtw_coarse_size);
+    uint8_t col_start = dtw_paa_start(path_lo[a], m, dtw_coarse_size);
+    uint8_t col_end = dtw_paa_start(path_hi[a] + 1, m, dtw_coarse_size);
+    uint8_t lo = (col_start > DTW_MULTIRES_RADIUS) ? col_start - DTW_MULTIRES_RADIUS : 0;
+    uint8_t hi = min(col_end - 1 + DTW_MULTIRES_RADIUS, m - 1);
+    row_start = (row_start > DTW_MULTIRES_RADIUS) ? row_start - DTW_MULTIRES_RADIUS : 0;
+    row_end = min(row_end + DTW_MULTIRES_RADIUS, collecter_size);
+    for (uint8_t i = row_start; i < row_end; i++) {
+      DTW_corridor_lo[i] = min(DTW_corridor_lo[i], lo);
+      DTW_corridor_hi[i] = max(DTW_corridor_hi[i], hi);
+    }
+  }
+  for (uint8_t i = 0; i < collecter_size; i++) {
+    uint8_t lo, hi;
+    dtw_window(i, m, lo, hi);
+    DTW_corridor_lo[i] = min(max(DTW_corridor_lo[i], lo), hi);
+    DTW_corridor_hi[i] = max(min(DTW_corridor_hi[i], hi), lo);
+  }
+  for (uint8_t i = collecter_size - 1; i > 0; i--) {
+    // The cell (i, lo) can only be reached from the cells (i - 1, lo - 1) and (i - 1, lo)
+    if (DTW_corridor_lo[i] > DTW_corridor_hi[i - 1] + 1) {
+      uint8_t lo, hi;
+      dtw_window(i - 1, m, lo, hi);
+      DTW_corridor_hi[i - 1] = min(DTW_corridor_lo[i] - 1, hi);
+      DTW_corridor_lo[i] = min(DTW_corridor_lo[i], DTW_corridor_hi[i - 1] + 1);
+    }
+  }
+}
+
+/// @brief Runs the full resolution DTW over the corridor only, abandoning once every cell of a row is above the bound
+/// @return the distance before it is normalised
+dtw_cost_t dtw_refine(uint8_t t, const int16_t query[][3], dtw_cost_t bound) {
+  dtw_begin(DTW_band);
+  for (uint8_t i = 0; i < collecter_size; i++) {
+    if (dtw_step(DTW_band, t, i, query[i], DTW_corridor_lo[i], DTW_corridor_hi[i]) > bound) {
+      return DTW_INFINITY;
+    }
+  }
+  return dtw_distance(DTW_band);
+}
+
+/// @brief Classifies the query with the coarse-to-fine DTW
+/// @param query the collected data
+/// @param distance is set to the refined, normalised distance of the chosen recording
+/// @return the index of the chosen template in DTW_TEMPLATES, or dtw_unknown if every candidate was rejected
+uint8_t classify_multires(const int16_t query[][3], dtw_cost_t& distance) {
+  dtw_paa(query, collecter_size, DTW_coarse_query, dtw_coarse_size);
+
+  // Keeping the closest recordings at the coarse resolution, sorted by coarse distance
+  uint8_t candidates[DTW_MULTIRES_CANDIDATES];
+  dtw_cost_t candidate_costs[DTW_MULTIRES_CANDIDATES];
+  // Where in DTW_coarse_path_lo and DTW_coarse_path_hi the path of each candidate is
+  uint8_t candidate_paths[DTW_MULTIRES_CANDIDATES];
+  uint8_t num_candidates = 0;
+  for (uint8_t t = 0; t < dtw_num_templates; t++) {
+    dtw_cost_t cost = dtw_coarse((const int16_t*) pgm_read_ptr(&gesture_coarse[t]));
+    if (num_candidates == DTW_MULTIRES_CANDIDATES && cost >= candidate_costs[DTW_MULTIRES_CANDIDATES - 1]) {
+      continue;
+    }
+    // The path of the candidate that drops out of the list, if it is full, is overwritten
+    const uint8_t path = (num_candidates < DTW_MULTIRES_CANDIDATES) ? num_candidates : candidate_paths[DTW_MULTIRES_CANDIDATES - 1];
+    uint8_t k = (num_candidates < DTW_MULTIRES_CANDIDATES) ? num_candidates++ : DTW_MULTIRES_CANDIDATES - 1;
+    while (k > 0 && candidate_costs[k - 1] > cost) {
+      candidates[k] = candidates[k - 1];
+      candidate_costs[k] = candidate_costs[k - 1];
+      candidate_paths[k] = candidate_paths[k - 1];
+      k--;
+    }
+    candidates[k] = t;
+    candidate_costs[k] = cost;
+    candidate_paths[k] = path;
+    dtw_coarse_trace(DTW_coarse_path_lo[path], DTW_coarse_path_hi[path]);
+  }
+
+  // Refining the candidates, the closest at the coarse resolution first so that it gives the tightest bound
+  uint8_t chosen = dtw_unknown;
+  distance = DTW_INFINITY;
+  for (uint8_t k = 0; k < num_candidates; k++) {
+    const uint8_t m = template_length(candidates[k]);
+    dtw_corridor(m, DTW_coarse_path_lo[candidate_paths[k]], DTW_coarse_path_hi[candidate_paths[k]]);
+    dtw_cost_t bound = dtw_denormalise(template_bound(candidates[k], distance), m);
+    dtw_cost_t curr = template_accept(candidates[k], dtw_normalise(dtw_refine(candidates[k], query, bound), m));
+    if (curr < distance) {
+      distance = curr;
+      chosen = candidates[k];
+    }
+  }
+  return chosen;
+}
@@ -0,0 +1,708 @@
+/*
+    Generated by tools/template_builder.cpp from the recordings in gestures.h, don't edit by hand. The tables
+    depend on the recordings and on the DTW options, so the builder has to be rerun whenever either changes.
+*/
+
+#ifdef __has_include
+    #if __has_include(<Arduino.h>)
+        #include <Arduino.h>
+    #endif
+#endif
+
+#define GESTURE_TABLES_LEN 20
+#define GESTURE_TABLES_WINDOW 1
+#define GESTURE_TABLES_RADIUS 4
+#define GESTURE_TABLES_COARSE_LEN 10
+#define GESTURE_TABLES_CENTROIDS 1
+#define GESTURE_TABLES_ORIENTATION 0
+#define GESTURE_TABLES_KERNEL 1
+#define GESTURE_TABLES_COST 0
+#define GESTURE_TABLES_SAX_SEGMENTS 10
+#define GESTURE_TABLES_SAX_ALPHABET 16
+#define GESTURE_TABLES_PACKED 0
+
+// DBA centroids, one per gesture, averaged from all of its recordings in gestures.h
+const int16_t PROGMEM centroid0[] = {
+    484, 45, -40,
+    500, -23, -45,
+    540, 135, -79,
+    470, 270, -99,
+    349, 283, -124,
+    303, 269, -119,
+    323, 183, -88,
+    381, -138, -107,
+    471, -55, -159,
+    388, 101, -224,
+    313, 264, -311,
+    359, 332, -388,
+    433, 218, -398,
+    433, 39, -323,
+    404, 53, -212,
+    404, 131, -160,
+    422, 123, -151,
+    458, 102, -142,
+    469, 91, -132,
+    470, 93, -130,
+    468, 93, -128,
+};
+
+const int16_t PROGMEM centroid1[] = {
+    449, 121, -184,
+    458, 126, -188,
+    498, 166, -195,
+    472, 212, -205,
+    392, 193, -203,
+    307, 103, -217,
+    313, -91, -174,
+    464, -107, -248,
+    556, 53, -350,
+    528, 103, -327,
+    373, 24, -252,
+    237, 80, -219,
+    199, 225, -301,
+    243, 342, -383,
+    321, 347, -454,
+    369, 236, -434,
+    340, 99, -307,
+    365, 61, -225,
+    415, 88, -227,
+    421, 98, -229,
+};
+
+const int16_t PROGMEM centroid2[] = {
+    478, 65, -125,
+    489, 66, -130,
+    530, 85, -121,
+    546, 136, -105,
+    455, 82, -92,
+    392, 59, -108,
+    353, 96, -100,
+    287, 110, -157,
+    431, 133, -187,
+    543, 119, -238,
+    521, 88, -293,
+    538, 134, -331,
+    541, 136, -281,
+    393, 91, -184,
+    348, 42, -150,
+    380, 62, -119,
+    315, 87, -170,
+    331, 91, -169,
+    447, 118, -187,
+    486, 139, -224,
+};
+
+const int16_t PROGMEM centroid3[] = {
+    482, 5, -50,
+    481, 24, -45,
+    408, 25, -44,
+    331, 38, -128,
+    405, 74, -295,
+    508, 106, -380,
+    480, 118, -385,
+    551, 164, -414,
+    425, 109, -309,
+    317, 51, -171,
+    353, 50, -134,
+    293, 66, -93,
+    221, 126, -104,
+    417, 156, -362,
+    444, 119, -435,
+    435, 146, -449,
+    535, 177, -505,
+    390, 92, -382,
+    291, 1, -202,
+    344, -5, -88,
+};
+
+const int16_t PROGMEM centroid4[] = {
+    450, 186, 89,
+    434, 243, 75,
+    394, 270, 67,
+    366, 300, 77,
+    306, 203, 4,
+    403, 62, -97,
+    469, 158, -280,
+    445, 294, -352,
+    419, 357, -351,
+    415, 376, -347,
+    367, 389, -292,
+    324, 355, -225,
+    325, 238, -116,
+    382, 97, 7,
+    446, 74, 55,
+    465, 113, 65,
+    467, 135, 72,
+    465, 144, 66,
+    468, 146, 57,
+    462, 165, 65,
+};
+
+const int16_t PROGMEM centroid5[] = {
+    478, 114, 90,
+    479, 114, 91,
+    473, 114, 90,
+    473, 110, 79,
+    477, 95, 125,
+    450, 124, 518,
+    319, 148, -96,
+    356, 113, -453,
+    424, 126, -229,
+    466, 131, -142,
+    462, 139, -127,
+    465, 123, -120,
+    464, 122, -118,
+    463, 126, -118,
+    466, 122, -118,
+    461, 122, -101,
+    475, 106, -87,
+    475, 108, -102,
+    480, 116, -115,
+    479, 112, -103,
+};
+
+const int16_t PROGMEM centroid6[] = {
+    462, 185, 45,
+    444, 269, 27,
+    399, 370, 21,
+    209, 360, -94,
+    191, -333, -184,
+    193, -834, -281,
+    -219, -422, -413,
+    -385, 542, -531,
+    -244, 951, -456,
+    -390, 636, -584,
+    -228, -309, -386,
+    174, -577, -196,
+    231, -761, -149,
+    -79, -386, -235,
+    -205, 379, -327,
+    -61, 602, -350,
+    59, 427, -269,
+    121, 417, -256,
+    145, 412, -259,
+    161, 407, -258,
+};
+
+const int16_t PROGMEM centroid7[] = {
+    480, 65, 114,
+    483, 63, 113,
+    515, 70, 125,
+    546, 80, 173,
+    276, 59, 88,
+    -35, -11, 25,
+    -238, -168, -292,
+    7, -286, -564,
+    398, -185, -448,
+    356, -65, -84,
+    158, 43, 14,
+    -99, 41, -74,
+    -362, -35, -194,
+    -337, -159, -488,
+    -212, -166, -578,
+    159, -78, -527,
+    300, -17, -302,
+    303, 16, -143,
+    391, 17, -83,
+    474, 43, -44,
+};
+
+const int16_t PROGMEM centroid8[] = {
+    486, 51, 92,
+    488, 54, 87,
+    481, 17, 87,
+    496, -98, -14,
+    470, 50, -246,
+    385, 461, -133,
+    365, 198, 60,
+    457, -260, -20,
+    486, -225, -272,
+    427, 223, -426,
+    409, 460, -169,
+    391, 127, 144,
+    467, -364, -7,
+    474, -262, -296,
+    458, 89, -401,
+    454, 416, -204,
+    423, 415, -42,
+    449, 14, 85,
+    460, -85, 32,
+    467, 118, -40,
+};
+
+const int16_t PROGMEM centroid9[] = {
+    478, 97, -51,
+    479, 100, -47,
+    529, 160, -53,
+    544, 251, -27,
+    439, 56, -53,
+    379, -24, -32,
+    311, 112, -59,
+    335, 187, -61,
+    550, 15, -138,
+    570, -90, -215,
+    505, -169, -227,
+    445, -72, -208,
+    420, 296, -195,
+    463, 246, -116,
+    464, 149, -116,
+    468, 132, -120,
+    469, 131, -122,
+    469, 131, -122,
+    469, 131, -122,
+    479, 38, -124,
+};
+
+const GestureDescriptor PROGMEM gesture_centroids[] = {
+    { centroid0, 21, 0, 0 },
+    { centroid1, 20, 1, 0 },
+    { centroid2, 20, 2, 0 },
+    { centroid3, 20, 3, 0 },
+    { centroid4, 20, 4, 0 },
+    { centroid5, 20, 5, 0 },
+    { centroid6, 20, 6, 0 },
+    { centroid7, 20, 7, 0 },
+    { centroid8, 20, 8, 0 },
+    { centroid9, 20, 9, 0 }
+};
+
+// LB_Keogh envelopes, one { upper x, upper y, upper z, lower x, lower y, lower z } entry per query sample
+const int16_t PROGMEM centroid0_envelope[] = {
+    540, 283, -40, 349, -23, -124,
+    540, 283, -40, 303, -23, -124,
+    540, 283, -40, 303, -23, -124,
+    540, 283, -40, 303, -138, -124,
+    540, 283, -40, 303, -138, -159,
+    540, 283, -45, 303, -138, -224,
+    540, 283, -79, 303, -138, -311,
+    471, 332, -88, 303, -138, -388,
+    471, 332, -88, 303, -138, -398,
+    471, 332, -88, 303, -138, -398,
+    471, 332, -107, 313, -138, -398,
+    471, 332, -151, 313, -55, -398,
+    458, 332, -142, 313, 39, -398,
+    469, 332, -132, 313, 39, -398,
+    470, 332, -130, 359, 39, -398,
+    470, 218, -128, 404, 39, -398,
+    470, 131, -128, 404, 39, -323,
+    470, 131, -128, 404, 53, -212,
+    470, 131, -128, 404, 91, -160,
+    470, 123, -128, 422, 91, -151,
+};
+
+const int16_t PROGMEM centroid1_envelope[] = {
+    498, 212, -184, 392, 121, -205,
+    498, 212, -184, 307, 103, -217,
+    498, 212, -174, 307, -91, -217,
+    498, 212, -174, 307, -107, -248,
+    556, 212, -174, 307, -107, -350,
+    556, 212, -174, 307, -107, -350,
+    556, 212, -174, 307, -107, -350,
+    556, 212, -174, 237, -107, -350,
+    556, 225, -174, 199, -107, -350,
+    556, 342, -174, 199, -107, -383,
+    556, 347, -174, 199, -107, -454,
+    556, 347, -219, 199, -107, -454,
+    556, 347, -219, 199, 24, -454,
+    528, 347, -219, 199, 24, -454,
+    415, 347, -219, 199, 24, -454,
+    421, 347, -219, 199, 61, -454,
+    421, 347, -225, 199, 61, -454,
+    421, 347, -225, 243, 61, -454,
+    421, 347, -225, 321, 61, -454,
+    421, 236, -225, 340, 61, -434,
+};
+
+const int16_t PROGMEM centroid2_envelope[] = {
+    546, 136, -92, 455, 65, -130,
+    546, 136, -92, 392, 59, -130,
+    546, 136, -92, 353, 59, -130,
+    546, 136, -92, 287, 59, -157,
+    546, 136, -92, 287, 59, -187,
+    546, 136, -92, 287, 59, -238,
+    546, 136, -92, 287, 59, -293,
+    546, 136, -92, 287, 59, -331,
+    543, 136, -92, 287, 59, -331,
+    543, 136, -100, 287, 59, -331,
+    543, 136, -100, 287, 42, -331,
+    543, 136, -119, 287, 42, -331,
+    543, 136, -119, 315, 42, -331,
+    543, 136, -119, 315, 42, -331,
+    541, 136, -119, 315, 42, -331,
+    541, 139, -119, 315, 42, -331,
+    541, 139, -119, 315, 42, -281,
+    486, 139, -119, 315, 42, -224,
+    486, 139, -119, 315, 42, -224,
+    486, 139, -119, 315, 62, -224,
+};
+
+const int16_t PROGMEM centroid3_envelope[] = {
+    482, 74, -44, 331, 5, -295,
+    508, 106, -44, 331, 5, -380,
+    508, 118, -44, 331, 5, -385,
+    551, 164, -44, 331, 5, -414,
+    551, 164, -44, 331, 5, -414,
+    551, 164, -44, 317, 24, -414,
+    551, 164, -44, 317, 25, -414,
+    551, 164, -93, 293, 38, -414,
+    551, 164, -93, 221, 50, -414,
+    551, 164, -93, 221, 50, -414,
+    551, 164, -93, 221, 50, -435,
+    551, 164, -93, 221, 50, -449,
+    535, 177, -93, 221, 50, -505,
+    535, 177, -93, 221, 50, -505,
+    535, 177, -93, 221, 1, -505,
+    535, 177, -88, 221, -5, -505,
+    535, 177, -88, 221, -5, -505,
+    535, 177, -88, 291, -5, -505,
+    535, 177, -88, 291, -5, -505,
+    535, 177, -88, 291, -5, -505,
+};
+
+const int16_t PROGMEM centroid4_envelope[] = {
+    450, 300, 89, 306, 186, 4,
+    450, 300, 89, 306, 62, -97,
+    469, 300, 89, 306, 62, -280,
+    469, 300, 89, 306, 62, -352,
+    469, 357, 89, 306, 62, -352,
+    469, 376, 77, 306, 62, -352,
+    469, 389, 77, 306, 62, -352,
+    469, 389, 77, 306, 62, -352,
+    469, 389, 4, 306, 62, -352,
+    469, 389, 7, 324, 62, -352,
+    469, 389, 55, 324, 74, -352,
+    465, 389, 65, 324, 74, -352,
+    467, 389, 72, 324, 74, -351,
+    467, 389, 72, 324, 74, -347,
+    468, 389, 72, 324, 74, -292,
+    468, 355, 72, 324, 74, -225,
+    468, 238, 72, 325, 74, -116,
+    468, 165, 72, 382, 74, 7,
+    468, 165, 72, 446, 74, 55,
+    468, 165, 72, 462, 113, 57,
+};
+
+const int16_t PROGMEM centroid5_envelope[] = {
+    479, 114, 125, 473, 95, 79,
+    479, 124, 518, 450, 95, 79,
+    479, 148, 518, 319, 95, -96,
+    479, 148, 518, 319, 95, -453,
+    479, 148, 518, 319, 95, -453,
+    479, 148, 518, 319, 95, -453,
+    477, 148, 518, 319, 95, -453,
+    477, 148, 518, 319, 95, -453,
+    477, 148, 518, 319, 95, -453,
+    466, 148, 518, 319, 113, -453,
+    466, 148, -96, 319, 113, -453,
+    466, 139, -101, 356, 113, -453,
+    475, 139, -87, 424, 106, -229,
+    475, 139, -87, 461, 106, -142,
+    480, 139, -87, 461, 106, -127,
+    480, 126, -87, 461, 106, -120,
+    480, 126, -87, 461, 106, -118,
+    480, 126, -87, 461, 106, -118,
+    480, 122, -87, 461, 106, -118,
+    480, 122, -87, 461, 106, -115,
+};
+
+const int16_t PROGMEM centroid6_envelope[] = {
+    462, 370, 45, 191, -333, -184,
+    462, 370, 45, 191, -834, -281,
+    462, 370, 45, -219, -834, -413,
+    462, 542, 45, -385, -834, -531,
+    462, 951, 45, -385, -834, -531,
+    444, 951, 27, -390, -834, -584,
+    399, 951, 21, -390, -834, -584,
+    209, 951, -94, -390, -834, -584,
+    231, 951, -149, -390, -834, -584,
+    231, 951, -149, -390, -834, -584,
+    231, 951, -149, -390, -761, -584,
+    231, 951, -149, -390, -761, -584,
+    231, 951, -149, -390, -761, -584,
+    231, 636, -149, -390, -761, -584,
+    231, 602, -149, -228, -761, -386,
+    231, 602, -149, -205, -761, -350,
+    231, 602, -149, -205, -761, -350,
+    161, 602, -235, -205, -386, -350,
+    161, 602, -256, -205, 379, -350,
+    161, 602, -256, -61, 407, -350,
+};
+
+const int16_t PROGMEM centroid7_envelope[] = {
+    546, 80, 173, 276, 59, 88,
+    546, 80, 173, -35, -11, 25,
+    546, 80, 173, -238, -168, -292,
+    546, 80, 173, -238, -286, -564,
+    546, 80, 173, -238, -286, -564,
+    546, 80, 173, -238, -286, -564,
+    546, 80, 173, -238, -286, -564,
+    546, 80, 173, -238, -286, -564,
+    398, 59, 88, -362, -286, -564,
+    398, 43, 25, -362, -286, -564,
+    398, 43, 14, -362, -286, -578,
+    398, 43, 14, -362, -286, -578,
+    398, 43, 14, -362, -185, -578,
+    356, 43, 14, -362, -166, -578,
+    391, 43, 14, -362, -166, -578,
+    474, 43, -44, -362, -166, -578,
+    474, 43, -44, -362, -166, -578,
+    474, 43, -44, -337, -166, -578,
+    474, 43, -44, -212, -166, -578,
+    474, 43, -44, 159, -78, -527,
+};
+
+const int16_t PROGMEM centroid8_envelope[] = {
+    496, 54, 92, 470, -98, -246,
+    496, 461, 92, 385, -98, -246,
+    496, 461, 92, 365, -98, -246,
+    496, 461, 92, 365, -260, -246,
+    496, 461, 92, 365, -260, -272,
+    496, 461, 87, 365, -260, -426,
+    496, 461, 87, 365, -260, -426,
+    496, 461, 144, 365, -260, -426,
+    486, 461, 144, 365, -364, -426,
+    486, 461, 144, 365, -364, -426,
+    486, 460, 144, 365, -364, -426,
+    486, 460, 144, 391, -364, -426,
+    486, 460, 144, 391, -364, -426,
+    474, 460, 144, 391, -364, -426,
+    474, 460, 144, 391, -364, -401,
+    474, 416, 144, 391, -364, -401,
+    474, 416, 85, 423, -364, -401,
+    474, 416, 85, 423, -262, -401,
+    467, 416, 85, 423, -85, -401,
+    467, 416, 85, 423, -85, -204,
+};
+
+const int16_t PROGMEM centroid9_envelope[] = {
+    544, 251, -27, 439, 56, -53,
+    544, 251, -27, 379, -24, -53,
+    544, 251, -27, 311, -24, -59,
+    544, 251, -27, 311, -24, -61,
+    550, 251, -27, 311, -24, -138,
+    570, 251, -27, 311, -90, -215,
+    570, 251, -27, 311, -169, -227,
+    570, 251, -27, 311, -169, -227,
+    570, 296, -32, 311, -169, -227,
+    570, 296, -32, 311, -169, -227,
+    570, 296, -59, 311, -169, -227,
+    570, 296, -61, 335, -169, -227,
+    570, 296, -116, 420, -169, -227,
+    570, 296, -116, 420, -169, -227,
+    505, 296, -116, 420, -169, -227,
+    479, 296, -116, 420, -72, -208,
+    479, 296, -116, 420, 38, -195,
+    479, 246, -116, 463, 38, -124,
+    479, 149, -116, 464, 38, -124,
+    479, 132, -120, 468, 38, -124,
+};
+
+const int16_t* const PROGMEM gesture_envelopes[] = {
+    centroid0_envelope,
+    centroid1_envelope,
+    centroid2_envelope,
+    centroid3_envelope,
+    centroid4_envelope,
+    centroid5_envelope,
+    centroid6_envelope,
+    centroid7_envelope,
+    centroid8_envelope,
+    centroid9_envelope
+};
+
+// Recordings averaged down to 10 samples for the coarse pass of the multi-resolution DTW
+const int16_t PROGMEM centroid0_coarse[] = {
+    492, 11, -42,
+    505, 202, -89,
+    326, 276, -121,
+    352, 22, -97,
+    429, 23, -191,
+    336, 298, -349,
+    433, 128, -360,
+    404, 92, -186,
+    440, 112, -146,
+    469, 92, -130,
+};
+
+const int16_t PROGMEM centroid1_coarse[] = {
+    453, 123, -186,
+    485, 189, -200,
+    349, 148, -210,
+    388, -99, -211,
+    542, 78, -338,
+    305, 52, -235,
+    221, 283, -342,
+    345, 291, -444,
+    352, 80, -266,
+    418, 93, -228,
+};
+
+const int16_t PROGMEM centroid2_coarse[] = {
+    483, 65, -127,
+    538, 110, -113,
+    423, 70, -100,
+    320, 103, -128,
+    487, 126, -212,
+    529, 111, -312,
+    467, 113, -232,
+    364, 52, -134,
+    323, 89, -169,
+    466, 128, -205,
+};
+
+const int16_t PROGMEM centroid3_coarse[] = {
+    481, 14, -47,
+    369, 31, -86,
+    456, 90, -337,
+    515, 141, -399,
+    371, 80, -240,
+    323, 58, -113,
+    319, 141, -233,
+    439, 132, -442,
+    462, 134, -443,
+    317, -2, -145,
+};
+
+const int16_t PROGMEM centroid4_coarse[] = {
+    442, 214, 82,
+    380, 285, 72,
+    354, 132, -46,
+    457, 226, -316,
+    417, 366, -349,
+    345, 372, -258,
+    353, 167, -54,
+    455, 93, 60,
+    466, 139, 69,
+    465, 155, 61,
+};
+
+const int16_t PROGMEM centroid5_coarse[] = {
+    478, 114, 90,
+    473, 112, 84,
+    463, 109, 321,
+    337, 130, -274,
+    445, 128, -185,
+    463, 131, -123,
+    463, 124, -118,
+    463, 122, -109,
+    475, 107, -94,
+    479, 114, -109,
+};
+
+const int16_t PROGMEM centroid6_coarse[] = {
+    453, 227, 36,
+    304, 365, -36,
+    192, -583, -232,
+    -302, 60, -472,
+    -317, 793, -520,
+    -27, -443, -291,
+    76, -573, -192,
+    -133, 490, -338,
+    90, 422, -262,
+    153, 409, -258,
+};
+
+const int16_t PROGMEM centroid7_coarse[] = {
+    481, 64, 113,
+    530, 75, 149,
+    120, 24, 56,
+    -115, -227, -428,
+    377, -125, -266,
+    29, 42, -30,
+    -349, -97, -341,
+    -26, -122, -552,
+    301, 0, -222,
+    432, 30, -63,
+};
+
+const int16_t PROGMEM centroid8_coarse[] = {
+    487, 52, 89,
+    488, -40, 36,
+    427, 255, -189,
+    411, -31, 20,
+    456, -1, -349,
+    400, 293, -12,
+    470, -313, -151,
+    456, 252, -302,
+    436, 214, 21,
+    463, 16, -4,
+};
+
+const int16_t PROGMEM centroid9_coarse[] = {
+    478, 98, -49,
+    536, 205, -40,
+    409, 16, -42,
+    323, 149, -60,
+    560, -37, -176,
+    475, -120, -217,
+    441, 271, -155,
+    466, 140, -118,
+    469, 131, -122,
+    474, 84, -123,
+};
+
+const int16_t* const PROGMEM gesture_coarse[] = {
+    centroid0_coarse,
+    centroid1_coarse,
+    centroid2_coarse,
+    centroid3_coarse,
+    centroid4_coarse,
+    centroid5_coarse,
+    centroid6_coarse,
+    centroid7_coarse,
+    centroid8_coarse,
+    centroid9_coarse
+};
+
+// Summary features, { mean, min, max, energy, crossings } for each axis (see dtw_features in dtw.h)
+const int16_t PROGMEM gesture_features[][15] = {
+    {421, 124, -169, 303, -138, -398, 540, 332, -40, 53, 92, 79, 5, 5, 1},
+    {386, 123, -266, 199, -107, -454, 556, 347, -174, 79, 85, 69, 4, 4, 4},
+    {440, 96, -173, 287, 42, -331, 546, 139, -92, 73, 24, 53, 4, 7, 3},
+    {405, 82, -248, 221, -5, -505, 551, 177, -44, 70, 49, 142, 5, 4, 4},
+    {413, 215, -68, 306, 62, -352, 469, 389, 89, 44, 88, 151, 4, 4, 2},
+    {454, 119, -51, 319, 95, -453, 480, 148, 518, 26, 9, 130, 2, 4, 1},
+    {48, 116, -256, -390, -834, -584, 462, 951, 45, 220, 444, 129, 4, 4, 5},
+    {178, -33, -158, -362, -286, -578, 546, 80, 173, 256, 87, 212, 4, 4, 4},
+    {449, 69, -84, 365, -364, -426, 496, 461, 144, 30, 187, 147, 6, 7, 6},
+    {463, 93, -110, 311, -169, -227, 570, 296, -27, 45, 90, 50, 4, 5, 1}
+};
+
+// Largest normalised DTW distance accepted for each template (see template_threshold in dtw.h)
+const uint32_t PROGMEM gesture_thresholds[] = {
+    5682,
+    6015,
+    5685,
+    4863,
+    3738,
+    2925,
+    9318,
+    5013,
+    7965,
+    6114
+};
+
+// SAX breakpoints, DTW_SAX_ALPHABET - 1 for each axis (see dtw_sax_symbol in dtw.h)
+const int16_t PROGMEM gesture_sax_breakpoints[][15] = {
+    {-54, 223, 302, 334, 364, 385, 411, 433, 449, 460, 472, 476, 482, 492, 526},
+    {-211, -60, -1, 28, 56, 73, 89, 105, 115, 130, 148, 164, 224, 303, 386},
+    {-440, -376, -302, -259, -222, -200, -179, -131, -123, -102, -81, -55, -12, 51, 93}
+};
+
+// SAX words of the buckets, { lo | hi << 4 } for each segment and axis
+const uint8_t PROGMEM gesture_sax_words[][30] = {
+    {0xF3, 0xD2, 0xC8, 0xF3, 0xD1, 0xC8, 0xF3, 0xD1, 0xC4, 0xF3, 0xE1, 0xB1, 0xA3, 0xE1, 0xA1, 0xA3, 0xE1, 0x91, 0xA3, 0xE4, 0x71, 0xA4, 0xE4, 0x81, 0xA6, 0xA4, 0x82, 0xA6, 0xA7, 0x87},
+    {0xE3, 0xC7, 0x65, 0xE3, 0xC1, 0x74, 0xF3, 0xC1, 0x72, 0xF2, 0xC1, 0x72, 0xF1, 0xE1, 0x71, 0xF1, 0xE1, 0x70, 0xF1, 0xE3, 0x50, 0x71, 0xE3, 0x50, 0x71, 0xE5, 0x40, 0x73, 0xE5, 0x40},
+    {0xF6, 0xA5, 0xA8, 0xF2, 0xA5, 0xA7, 0xF2, 0xA5, 0xA4, 0xF2, 0xA5, 0xA2, 0xF2, 0xA5, 0xA2, 0xF2, 0xA4, 0xA2, 0xF3, 0xA4, 0x92, 0xF3, 0xA4, 0x92, 0xF3, 0xA4, 0x93, 0xD3, 0xA4, 0x94},
+    {0xE3, 0x83, 0xC1, 0xF3, 0xC3, 0xC1, 0xF3, 0xC3, 0xC1, 0xF2, 0xC3, 0xC1, 0xF1, 0xC4, 0xA1, 0xF1, 0xC4, 0xA0, 0xF1, 0xC4, 0xA0, 0xF1, 0xC2, 0xA0, 0xF1, 0xC2, 0xA0, 0xF2, 0xC2, 0xA0},
+    {0x93, 0xD5, 0xEA, 0xA3, 0xD5, 0xE2, 0xA3, 0xE5, 0xE2, 0xA3, 0xF5, 0xE2, 0xA3, 0xF5, 0xD2, 0xA3, 0xF6, 0xE2, 0xA3, 0xF6, 0xE2, 0xA3, 0xF6, 0xE3, 0xA3, 0xD6, 0xE9, 0xA8, 0xC6, 0xEE},
+    {0xC9, 0x97, 0xFE, 0xC3, 0xB7, 0xF0, 0xC3, 0xB7, 0xF0, 0xC3, 0xB7, 0xF0, 0xC3, 0xB7, 0xF0, 0xA3, 0xB8, 0xA0, 0xB7, 0xA8, 0xA4, 0xCA, 0xA8, 0xA8, 0xCA, 0x98, 0xA9, 0xCA, 0x98, 0xA9},
+    {0xA1, 0xE0, 0xD3, 0xA0, 0xF0, 0xD0, 0xA0, 0xF0, 0xD0, 0x60, 0xF0, 0xD0, 0x20, 0xF0, 0x70, 0x20, 0xF0, 0x70, 0x20, 0xF0, 0x70, 0x20, 0xF0, 0x71, 0x20, 0xF0, 0x72, 0x10, 0xFE, 0x42},
+    {0xF1, 0x62, 0xFD, 0xF0, 0x60, 0xF0, 0xF0, 0x60, 0xF0, 0xF0, 0x60, 0xF0, 0x60, 0x50, 0xE0, 0x60, 0x40, 0xD0, 0x60, 0x41, 0xD0, 0xB0, 0x41, 0xD0, 0xB0, 0x41, 0xC0, 0xB0, 0x41, 0xC0},
+    {0xE6, 0xF1, 0xE4, 0xE5, 0xF0, 0xE4, 0xE5, 0xF0, 0xE1, 0xE5, 0xF0, 0xF1, 0xD5, 0xF0, 0xF1, 0xD5, 0xF0, 0xF1, 0xD6, 0xF0, 0xF1, 0xB6, 0xF0, 0xF1, 0xB7, 0xF0, 0xE1, 0xA7, 0xF1, 0xE1},
+    {0xF5, 0xD2, 0xCC, 0xF3, 0xD2, 0xCB, 0xF3, 0xD1, 0xC5, 0xF3, 0xD1, 0xC4, 0xF3, 0xD1, 0xC4, 0xF3, 0xD1, 0xB4, 0xF7, 0xD1, 0x94, 0xE7, 0xD1, 0x94, 0xC7, 0xD4, 0x96, 0xCA, 0xB4, 0x98}
+};
+
+// The templates of bucket b are gesture_sax_members[gesture_sax_bucket_starts[b]] up to the start of bucket b + 1
+const uint8_t PROGMEM gesture_sax_bucket_starts[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+const uint8_t PROGMEM gesture_sax_members[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
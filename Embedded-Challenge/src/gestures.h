@@ -512,27 +512,55 @@ const int16_t PROGMEM gesture9_1[] = {
 };
 
 
-const int16_t* gestures[] = {
-    gesture0,
-    gesture1,
-    gesture2, 
-    gesture3,
-    gesture4,
-    gesture5,
-    gesture6,
-    gesture7,
-    gesture8,
-    gesture9,
-    gesture0_1,
-    gesture1_1,
-    gesture2_1, 
-    gesture3_1,
-    gesture4_1,
-    gesture5_1,
-    gesture6_1,
-    gesture7_1,
-    gesture8_1,
-    gesture9_1
+/// @brief Describes one of the recordings
+struct GestureDescriptor {
+    const int16_t* data; // The samples { ax, ay, az } of the recording, in the flash
+    uint8_t length; // How many samples the recording holds
+    uint8_t label; // Which gesture was recorded, as an index in gesture_names
+    uint8_t trial; // Which recording of that gesture this is
+};
+
+/*
+    Describes a recording packed by tools/template_builder.cpp (see DTW_PACKED_TEMPLATES in dtw.h), where every axis of
+    every sample is a signed byte code, decoded as base + code * scale.
+*/
+struct PackedGestureDescriptor {
+    const int8_t* data; // The codes { cx, cy, cz } of the samples, in the flash
+    int16_t base[3]; // The base of each axis
+    uint8_t scale[3]; // The scale of each axis
+    uint8_t length; // How many samples the recording holds
+    uint8_t label; // Which gesture was recorded, as an index in gesture_names
+    uint8_t trial; // Which recording of that gesture this is
+};
+
+// Describes a recording, its length is taken from the size of its array
+#define GESTURE(samples, label, trial) { samples, sizeof(samples) / sizeof(samples[0]) / 3, label, trial }
+
+/*
+    All the recordings. The table is held in the flash like the recordings themselves, so its entries have to be read
+    with pgm_read_*() (see template_data() and the other accessors in dtw.h).
+*/
+const GestureDescriptor PROGMEM gestures[] = {
+    GESTURE(gesture0, 0, 0),
+    GESTURE(gesture1, 1, 0),
+    GESTURE(gesture2, 2, 0),
+    GESTURE(gesture3, 3, 0),
+    GESTURE(gesture4, 4, 0),
+    GESTURE(gesture5, 5, 0),
+    GESTURE(gesture6, 6, 0),
+    GESTURE(gesture7, 7, 0),
+    GESTURE(gesture8, 8, 0),
+    GESTURE(gesture9, 9, 0),
+    GESTURE(gesture0_1, 0, 1),
+    GESTURE(gesture1_1, 1, 1),
+    GESTURE(gesture2_1, 2, 1),
+    GESTURE(gesture3_1, 3, 1),
+    GESTURE(gesture4_1, 4, 1),
+    GESTURE(gesture5_1, 5, 1),
+    GESTURE(gesture6_1, 6, 1),
+    GESTURE(gesture7_1, 7, 1),
+    GESTURE(gesture8_1, 8, 1),
+    GESTURE(gesture9_1, 9, 1)
 };
 
 const char PROGMEM gesture_names[] = {
@@ -546,4 +574,4 @@ const char PROGMEM gesture_names[] = {
     'S', // Swim
     '0', // Whirlpool
     'T' // Triangle
-};
\ No newline at end of file
+};
@@ -16,6 +16,18 @@
 #include "LIS3DH.h"
 #define LIS3DH_OWN 0
 #endif
+#ifndef ACCEL_FIFO_OWN
+#define ACCEL_FIFO_OWN 0
+#include "accel_fifo.h"
+#endif
+#ifndef ACCEL_TIMER_OWN
+#define ACCEL_TIMER_OWN 0
+#include "accel_timer.h"
+#endif
+#ifndef ACCEL_STILL_OWN
+#define ACCEL_STILL_OWN 0
+#include "accel_still.h"
+#endif
 #ifndef SPEAKER
 #define SPEAKER 0
 #include "speaker.h"
@@ -27,8 +39,6 @@
 #define MAX_GESTURE_LEN 2.99
 #define WINDOW_SIZE 5
 #define NO_MOTION_THRESHOLD 0.15
-#define NUM_GESTURES 10
-#define NUM_TRIALS 2
 #define IDLE_FREQ 2
 #define ACTIVE_FREQ 7
 #include "Copied_Adafruit.h"
@@ -39,26 +49,35 @@ using namespace std;
   Accelerometer handling objects.
   The chosen accelerometer settings are:
   - Max/Min acceleration = +/- 4g
-  - Frequency 10 Hz (acceleration is measured every 100 ms)
+  - Frequency derived from how often collect() reads it (see set_sensor_rate), starting at the idle one
   - High Power Mode to allow for higher precision in reading the data
   - All 3 channels ENABLED
 */
-LIS3DHSettings settings = LIS3DHSettings(4, 10, (PM) H, ENABLED, ENABLED, ENABLED);
+LIS3DHSettings settings = LIS3DHSettings(4, LIS3DHSettings::Freq_for_Rate(IDLE_FREQ * WINDOW_SIZE), (PM) H, ENABLED, ENABLED, ENABLED);
+static_assert(LIS3DHSettings::Freq_for_Rate(ACTIVE_FREQ * WINDOW_SIZE) != 0, "The accelerometer can't be read that often");
+static_assert(!ACCEL_STILL || NO_MOTION_TIME * LIS3DHSettings::Freq_for_Rate(IDLE_FREQ * WINDOW_SIZE) <= 127,
+              "The accelerometer can only count up to 127 samples of stillness");
 LIS3DH LIS3DH_Handler = LIS3DH(settings);
 
 /*
 'i' = Idle (Lasts as long as the user doesn't stay still)
 - Data collector has low frequency (IDLE_FREQ)
 - Changes to data collection upon detecting a start configuration (holding still for NO_MOTION_TIME seconds)
+- With ACCEL_STILL, the accelerometer detects the start configuration itself, and the MCU sleeps until then
+- With ORIENTATION_NORMALISE, the still period gives the tilt of the board, and the gesture is rotated to undo it
 'a' = Active data collection (Lasts MAX_GESTURE_LEN seconds or until the user reverts the board back to the idle frequency mode)
 - Data is collected at high frequency (ACTIVE_FREQ) into the data collector
+- With DTW_EARLY_DECISION, goes straight to the display state as soon as one gesture clearly dominates
 - Goes back to idle state if (left/right) button is pressed *******
 'p' = Processing (Lasts as many seconds as it takes to perform the algorithm to run)
 - All data collection is paused
 - DTW algorithm runs to compute the distances of the collected data from each of the prior recordings
+- With DTW_TIME_SLICED, the algorithm only runs for a slice of time in each loop, and the neopixels show its progress
+- Goes back to idle state if left button is pressed
 - The minimum distance decides the chosen gesture
 'd' = Display (Lasts until user presees the button)
 - Corresponding neopixel is turned on
+- If the motion was rejected as unknown (too far from every gesture), every neopixel is dimly lit in red instead
 - Goes back to idle if (left/right) button is pressed ******
 */
 char state = 'i';
@@ -70,6 +89,7 @@ char state = 'i';
 */ 
 long subtotals[3] = {0};
 int window_index = 0;
+uint16_t window_phase = 0; // With ACCEL_FIFO, goes up by the frequency with every sample, the window is full once it reaches sensor_odr
 
 long prev_last_ms;
 long last_ms;
@@ -90,9 +110,49 @@ int16_t collecter[collecter_size][3] {{0}}; // Holds data { ax, ay, az }
 int collecter_index = 0;
 
 /*
-  The DTW matrix is used to compute the DTW distance between the collected data and the previous data
+  The DTW engine is used to compute the DTW distance between the collected data and the previous data
 */
-float DTW_matrix[collecter_size + 1][collecter_size + 1] {{INFINITY}};
+#ifndef GESTURE_TABLES
+#define GESTURE_TABLES 0
+#include "gesture_tables.h"
+#endif
+#ifndef DTW
+#define DTW 0
+#include "dtw.h"
+#endif
+#ifndef DTW_BENCHMARK_OWN
+#define DTW_BENCHMARK_OWN 0
+#include "dtw_benchmark.h"
+#endif
+#ifndef DTW_MULTIRES_OWN
+#define DTW_MULTIRES_OWN 0
+#include "dtw_multires.h"
+#endif
+#ifndef DTW_JOB_OWN
+#define DTW_JOB_OWN 0
+#include "dtw_job.h"
+#endif
+#ifndef ORIENTATION_OWN
+#define ORIENTATION_OWN 0
+#include "orientation.h"
+#endif
+
+// The classifiers are exclusive, and only the cascade goes through the candidates of DTW_SHORTLIST and DTW_SAX_INDEX
+#if DTW_MULTIRES && (DTW_STREAMING || DTW_INTERLEAVED || DTW_TIME_SLICED)
+#error "DTW_MULTIRES can't be combined with DTW_STREAMING, DTW_INTERLEAVED or DTW_TIME_SLICED"
+#endif
+#if DTW_INTERLEAVED && (DTW_STREAMING || DTW_TIME_SLICED)
+#error "DTW_INTERLEAVED can't be combined with DTW_STREAMING or DTW_TIME_SLICED"
+#endif
+#if DTW_TIME_SLICED && DTW_STREAMING
+#error "DTW_TIME_SLICED can't be combined with DTW_STREAMING, whose distances are already computed"
+#endif
+#if (DTW_MULTIRES || DTW_INTERLEAVED) && (DTW_SHORTLIST || DTW_SAX_INDEX)
+#error "DTW_MULTIRES and DTW_INTERLEAVED match every template, they can't be combined with DTW_SHORTLIST or DTW_SAX_INDEX"
+#endif
+
+/// @brief The rotation into the canonical frame of orientation.h, set from the still period before each gesture
+int16_t orientation_matrix[3][3];
 
 /// @brief Adds a wait between checking whent he start condition has started to ensure the code doesn't spend most of the time checking the start condition
 uint8_t wait_between_checks = 0;
@@ -100,6 +160,12 @@ uint8_t wait_between_checks = 0;
 /// @brief Holds the chosen gesture as a result of the DTW algorithm
 uint8_t chosen_gesture;
 
+/// @brief How many neopixels are lit to show the progress of the classification
+uint8_t progress_pixels = 0;
+
+/// @brief Whether the classification of the collected data has been started, it is cleared when the processing state is entered
+bool classify_started = false;
+
 
 /// @brief Sets up all functionalities before entering the loop
 void setup() {
@@ -120,33 +186,61 @@ void setup() {
   LIS3DH_Handler = LIS3DH(settings); // Initializing the LIS3DH handler with the chosen settings
   LIS3DH_Handler.SetupAccelerometer(); // Setting up the accelerometer
 
-  // Setting up the DTW matrix to hold infinity in the beginning
-  for (int r = collecter_size; r >= 0; r--) {
-    for (int c = 0; c < collecter_size; c++) {
-      DTW_matrix[r][c] = INFINITY;
-    }
-  }
+#if DTW_BENCHMARK
+  dtw_benchmark(collecter); // The collecter is only borrowed, it gets overwritten once the data collection begins
+#endif
 
   sing((Song) MARIO); // By the end of the song, everything is ready and the idle state begins
+
+#if ACCEL_FIFO
+  accel_fifo_begin(LIS3DH_Handler); // The samples are buffered by the accelerometer from now on
+#elif ACCEL_TIMER
+  accel_timer_begin(LIS3DH_Handler, IDLE_FREQ * WINDOW_SIZE); // The samples are read by Timer3 from now on
+#endif
+#if ACCEL_STILL
+  // The stillness is counted in samples at the idle data rate, which the accelerometer is at whenever it is idle
+  accel_still_begin(LIS3DH_Handler, settings.Threshold_to_Byte(ACCEL_STILL_THRESHOLD),
+                    NO_MOTION_TIME * LIS3DHSettings::Freq_for_Rate(IDLE_FREQ * WINDOW_SIZE));
+#endif
   
   last_ms = millis(); // Recording the current time to calculate the change in time later
 }
 
+/// @brief The frequency collect() was last called with, and the data rate the accelerometer was set to for it
+uint8_t sensor_frequency = 0;
+uint16_t sensor_odr = LIS3DHSettings::Freq_for_Rate(IDLE_FREQ * WINDOW_SIZE);
+
 /*
-  Performs the DTW algorithm and returns the computed distance. The Domain Time Warping (DTW) algorithm attempts to find the best mapping
-  between the points of one time series and another. The algorithm calculates all possible mappings at each step, assumes the minimum, 
-  and proceeds to do that again with that assumption in mind. By the end of the algorithm, the minimum distance is going to be held in the
-  top right entry of the matrix.
+  Sets the accelerometer to the slowest data rate at which it has a new sample every time collect(frequency) reads it,
+  so that no read returns the same sample twice, while idling at a low power rate. It only does something when the
+  frequency changes, that is when the state goes between idle and active. The window being averaged is started afresh,
+  since it was collected at the previous rate.
 */
-float calculate_DTW(const int16_t* gesture) {
-  DTW_matrix[0][0] = 0;
-  for (int r = 1; r < collecter_size + 1; r++) {
-    for (int c = 1; c < collecter_size + 1; c++) {
-      float dist = sqrt(pow((int16_t)pgm_read_word(gesture + (r - 1) * 3 + 0) - (float)collecter[(c-1)][0], 2) + pow((int16_t)pgm_read_word(gesture + (r - 1) * 3 + 1) - (float)collecter[(c-1)][1], 2) + pow( (int16_t)pgm_read_word(gesture + (r - 1) * 3 + 2) - (float) collecter[(c-1)][2], 2) );
-      DTW_matrix[r][c] = abs(dist + min(DTW_matrix[r - 1][c - 1], min(DTW_matrix[r - 1][c], DTW_matrix[r][c - 1])));
-    }
+void set_sensor_rate(uint8_t frequency) {
+  if (frequency == sensor_frequency) {
+    return;
   }
-  return DTW_matrix[collecter_size][collecter_size];
+  sensor_frequency = frequency;
+  sensor_odr = LIS3DHSettings::Freq_for_Rate(frequency * WINDOW_SIZE);
+  const uint8_t sreg = SREG; // The FIFO and timer interrupts use the SPI bus too
+  cli();
+  LIS3DH_Handler.setFreq(sensor_odr);
+#if ACCEL_STILL
+  // The stillness is counted in samples at the data rate, and the state is going back to idle or leaving it
+  accel_still_arm(LIS3DH_Handler);
+#endif
+#if ACCEL_FIFO
+  // The samples taken at the old rate are dropped, from the FIFO (going through the bypass mode) and from the ring
+  LIS3DH_Handler.setFIFO(ACCEL_FIFO_WATERMARK);
+  Accel_fifo_ring.clear();
+#endif
+  SREG = sreg;
+#if ACCEL_TIMER
+  accel_timer_rate(frequency * WINDOW_SIZE);
+#endif
+  window_index = 0;
+  window_phase = 0;
+  subtotals[0] = subtotals[1] = subtotals[2] = 0;
 }
 
 /*
@@ -156,16 +250,49 @@ float calculate_DTW(const int16_t* gesture) {
   filter is slightly different from what we implemented in class but the result is still the same.
 */
 bool collect(uint8_t frequency) {
+  set_sensor_rate(frequency);
+#if ACCEL_FIFO
+  // The samples come at the rate of the accelerometer, and every 1 / frequency seconds worth of them are averaged
+  LIS3DHSample sample;
+  bool window_full = false;
+  while (!window_full && Accel_fifo_ring.pop(sample)) {
+    subtotals[0] += sample.x;
+    subtotals[1] += sample.y;
+    subtotals[2] += sample.z;
+    window_index++;
+    window_phase += frequency;
+    if (window_phase >= sensor_odr) {
+      window_phase -= sensor_odr;
+      window_full = true;
+    }
+  }
+  if (window_full) {
+    average_time_diff = (average_time_diff * count_ticks + (float) window_index / sensor_odr) / (count_ticks + 1);
+#elif ACCEL_TIMER
+  // The timer reads the samples exactly WINDOW_SIZE times per window
+  LIS3DHSample sample;
+  while (window_index < WINDOW_SIZE && Accel_timer_ring.pop(sample)) {
+    subtotals[0] += sample.x;
+    subtotals[1] += sample.y;
+    subtotals[2] += sample.z;
+    window_index++;
+  }
+  if (window_index == WINDOW_SIZE) {
+    average_time_diff = 1.0 / frequency;
+#else
   if (millis() - last_ms >= 1000.0 / (frequency * WINDOW_SIZE)) {
     prev_last_ms = last_ms;
     last_ms = millis();
-    subtotals[0] += LIS3DH_Handler.getXRaw();
-    subtotals[1] += LIS3DH_Handler.getYRaw();
-    subtotals[2] += LIS3DH_Handler.getZRaw();
+    LIS3DHSample sample;
+    LIS3DH_Handler.getXYZRaw(sample);
+    subtotals[0] += sample.x;
+    subtotals[1] += sample.y;
+    subtotals[2] += sample.z;
     window_index++;
   }
   if (window_index == WINDOW_SIZE) {
     average_time_diff = (average_time_diff * count_ticks + (float) (last_ms - prev_last_ms) * (float) WINDOW_SIZE / 1000.0) / (count_ticks + 1);
+#endif
     count_ticks ++;
     collecter[collecter_index][0] = subtotals[0] / window_index ;
     collecter[collecter_index][1] = subtotals[1] / window_index ;
@@ -177,6 +304,12 @@ bool collect(uint8_t frequency) {
     Serial.print(F(", "));
     Serial.print(collecter[collecter_index][2]);
     Serial.print(F(",\n"));
+#if ORIENTATION_NORMALISE
+    // Printed as measured, since the template builder does its own rotation of the recordings
+    if (state == 'a') {
+      orientation_rotate(orientation_matrix, collecter[collecter_index]);
+    }
+#endif
     collecter_index++;
     window_index = 0;
     subtotals[0] = subtotals[1] = subtotals[2] = 0;
@@ -217,11 +350,55 @@ void flush(int16_t acceleration_collector[][3], int& index, int size) {
   average_time_diff = 0;
 }
 
+/// @brief Goes to the active state once the start condition was met
+void start_gesture() {
+  state = 'a';
+  flush(collecter, collecter_index, collecter_size);
+  sing((Song) START);
+  Serial.println(F("---------------"));
+}
+
+/*
+  Classifies the collected data with the classifier selected at compile time. With DTW_TIME_SLICED, the job is started on
+  the first call after the collection, each call only runs a slice of it, and the neopixels show its progress.
+  Returns whether the classification is done, the chosen gesture and its distance are only set then.
+*/
+bool classify(uint8_t& chosen, dtw_cost_t& distance) {
+#if DTW_MULTIRES
+  // Only the closest recordings at the coarse resolution are compared at the full resolution
+  chosen = classify_multires(collecter, distance);
+#elif DTW_INTERLEAVED
+  // All the recordings are matched together in a single sweep over the collected data
+  chosen = classify_interleaved(collecter, distance);
+#elif DTW_TIME_SLICED
+  if (!classify_started) {
+    DTW_job.begin(collecter);
+    progress_pixels = 0;
+    classify_started = true;
+  }
+  // Only a slice of the classification runs in each loop so the buttons and the neopixels keep being handled
+  if (!DTW_job.run(dtw_slice_us)) {
+    uint8_t pixels = (uint16_t) DTW_job.progress() * 10 / DTW_job.size();
+    while (progress_pixels < pixels) {
+      CircuitPlayground.setPixelColor(progress_pixels++, 0, 0, 60);
+    }
+    return false;
+  }
+  chosen = DTW_job.result();
+  distance = DTW_job.distance();
+#else
+  // The cheap lower bounds are checked first, only the recordings that could still beat the best distance so far reach
+  // the DTW (with DTW_STREAMING, the distances were already computed while the data was being collected)
+  chosen = classify_cascade(collecter, distance);
+#endif
+  return true;
+}
+
 bool just_added = false;
 
 void loop() {
-  // Check if left button is pressed and the program is currently in the active state
-  if (((PIND >> 4) & 1) && state == 'a') {
+  // Check if left button is pressed and the program is currently in the active or processing state
+  if (((PIND >> 4) & 1) && (state == 'a' || state == 'p')) {
     // Go to the idle state and clear the collector
     state = 'i';
     CircuitPlayground.clearPixels();
@@ -246,16 +423,36 @@ void loop() {
   switch (state) {
     // IDLE
     case 'i': {
+#if ACCEL_STILL
+      set_sensor_rate(IDLE_FREQ); // The accelerometer counts the stillness at the idle data rate
+      if (accel_still()) {
+#if ORIENTATION_NORMALISE
+        // The board is still, so a sample only measures gravity
+        LIS3DHSample sample;
+        const uint8_t sreg = SREG; // With ACCEL_TIMER, its interrupt uses the SPI bus too
+        cli();
+        LIS3DH_Handler.getXYZRaw(sample);
+        SREG = sreg;
+        const int16_t gravity[1][3] = {{sample.x, sample.y, sample.z}};
+        orientation_frame(gravity, 1, orientation_matrix);
+#endif
+        start_gesture();
+      }
+      else {
+        accel_still_sleep(); // Until the accelerometer, or anything else, interrupts
+      }
+#else
       if (collecter_index < collecter_size) {
         just_added = collect(IDLE_FREQ);
         if (just_added) {
           wait_between_checks++;
           if (wait_between_checks >= NO_MOTION_TIME * IDLE_FREQ) {
             if (check_start()) {
-              state = 'a';
-              flush(collecter, collecter_index, collecter_size);
-              sing((Song) START);
-              Serial.println(F("---------------"));
+#if ORIENTATION_NORMALISE
+              // The samples check_start() just found still only measure gravity
+              orientation_frame(collecter + collecter_index - NO_MOTION_TIME * IDLE_FREQ, NO_MOTION_TIME * IDLE_FREQ, orientation_matrix);
+#endif
+              start_gesture();
             }
           }
         }
@@ -264,31 +461,45 @@ void loop() {
         flush(collecter, collecter_index, collecter_size);
         CircuitPlayground.clearPixels();
       }
+#endif
     }
     break;
     // ACTIVE DATA COLLECTION
     case 'a': {
       if (collecter_index < collecter_size) {
+#if DTW_STREAMING
+        if (collect(ACTIVE_FREQ)) {
+          // The new sample is matched against the recordings right away so the DTW is done when the collection is
+          dtw_stream_step(collecter_index - 1, collecter[collecter_index - 1]);
+#if DTW_EARLY_DECISION
+          // Once one gesture clearly dominates, the rest of the window is skipped
+          if (dtw_early_decision(collecter_index - 1, chosen_gesture)) {
+            state = 'd';
+            just_added = true;
+            sing((Song) PROCESSING);
+            Serial.println(F("-------------"));
+          }
+#endif
+        }
+#else
         collect(ACTIVE_FREQ);
+#endif
       }
       else {
         state = 'p';
+        classify_started = false;
         sing((Song) PROCESSING);
+        Serial.println(F("-------------"));
       }
     }
     break;
     // PROCESSING
     case 'p': {
-      Serial.println(F("-------------"));
-      float min = INFINITY;
-      for (int i = 0; i < NUM_GESTURES * NUM_TRIALS; i++) {
-        float curr = calculate_DTW(gestures[i]);
-        Serial.println(curr);
-        if (curr < min) {
-          min = curr;
-          chosen_gesture = i;
-        }
+      dtw_cost_t distance;
+      if (!classify(chosen_gesture, distance)) {
+        break;
       }
+      Serial.println(distance);
       state = 'd';
       just_added = true;
     }
@@ -297,9 +508,18 @@ void loop() {
     case 'd': {
       if (just_added) {
         Serial.print(F("Chose: "));
-        Serial.println(char(pgm_read_byte(gesture_names + (chosen_gesture % NUM_GESTURES))));
         CircuitPlayground.clearPixels();
-        CircuitPlayground.setPixelColor(chosen_gesture % NUM_GESTURES, 128, 50, 30);
+        if (chosen_gesture == dtw_unknown) {
+          // The motion was too far from every gesture, every neopixel is dimly lit in red instead
+          Serial.println(F("unknown"));
+          for (uint8_t i = 0; i < 10; i++) {
+            CircuitPlayground.setPixelColor(i, 30, 0, 0);
+          }
+        }
+        else {
+          Serial.println(char(pgm_read_byte(gesture_names + template_label(chosen_gesture))));
+          CircuitPlayground.setPixelColor(template_label(chosen_gesture), 128, 50, 30);
+        }
         flush(collecter, collecter_index, collecter_size);
         Serial.println(F("-------------"));
         just_added = false;
@@ -0,0 +1,86 @@
+/*
+    Orientation normalisation, shared by the firmware and tools/template_builder.cpp. The same gesture recorded with the
+    board held at a slightly different tilt gives different accelerations on every axis, since gravity is split between
+    them differently, and it would otherwise take a recording for every tilt to recognise it. Before the gesture, while
+    the board is held still, the accelerometer only measures gravity. Its direction gives the tilt of the board, and
+    every sample of the gesture is then rotated by the smallest rotation that brings that direction onto the +X axis, the
+    way the board is held in the recordings. The rotation around gravity can't be seen by the accelerometer and is left
+    as is.
+
+    The firmware estimates gravity from the still samples that check_start() accepted (or, with ACCEL_STILL, from a
+    sample read once the accelerometer found the board still), and the builder from the first samples of each
+    recording, which directly follow the same still period.
+*/
+
+#ifdef __has_include
+    #if __has_include(<Arduino.h>)
+        #include <Arduino.h>
+    #endif
+#endif
+
+#include <math.h>
+
+#ifndef ORIENTATION_NORMALISE
+#define ORIENTATION_NORMALISE 0
+#endif
+
+#ifndef ORIENTATION_MAX_TILT
+#define ORIENTATION_MAX_TILT 60 // The largest tilt from the +X axis, in degrees, that is corrected, beyond it nothing is rotated
+#endif
+
+/// @brief The fixed point of the rotation matrices, 1 << orientation_shift is 1.0
+const uint8_t orientation_shift = 14;
+
+/*
+  Fills frame with the rotation (in fixed point) that brings the average of the count samples onto the +X axis. The
+  rotation by the angle between them around their cross product v is I + [v] + [v]^2 / (1 + cos), where [v] is the
+  cross product matrix of v. If the samples average to nothing or the tilt is over ORIENTATION_MAX_TILT, frame is left
+  as the identity.
+*/
+void orientation_frame(const int16_t samples[][3], uint8_t count, int16_t frame[3][3]) {
+  float gravity[3] = {0, 0, 0};
+  for (uint8_t i = 0; i < count; i++) {
+    for (uint8_t k = 0; k < 3; k++) {
+      gravity[k] += samples[i][k];
+    }
+  }
+  const float norm = sqrt(gravity[0] * gravity[0] + gravity[1] * gravity[1] + gravity[2] * gravity[2]);
+  float rotation[3][3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+  if (norm > 0 && gravity[0] / norm >= cos(ORIENTATION_MAX_TILT * M_PI / 180)) {
+    // v = g x (1, 0, 0) = (0, gz, -gy) and cos = gx, for the unit gravity g
+    const float c = gravity[0] / norm;
+    const float vy = gravity[2] / norm;
+    const float vz = -gravity[1] / norm;
+    const float f = 1 / (1 + c);
+    rotation[0][0] = 1 - (vy * vy + vz * vz) * f;
+    rotation[0][1] = -vz;
+    rotation[0][2] = vy;
+    rotation[1][0] = vz;
+    rotation[1][1] = 1 - vz * vz * f;
+    rotation[1][2] = vy * vz * f;
+    rotation[2][0] = -vy;
+    rotation[2][1] = vy * vz * f;
+    rotation[2][2] = 1 - vy * vy * f;
+  }
+  for (uint8_t a = 0; a < 3; a++) {
+    for (uint8_t b = 0; b < 3; b++) {
+      frame[a][b] = (int16_t) round(rotation[a][b] * (1 << orientation_shift));
+    }
+  }
+}
+
+/// @brief Rotates a sample { ax, ay, az } in place by the rotation of orientation_frame()
+void orientation_rotate(const int16_t frame[3][3], int16_t sample[3]) {
+  int32_t rotated[3];
+  for (uint8_t a = 0; a < 3; a++) {
+    rotated[a] = (int32_t) frame[a][0] * sample[0] + (int32_t) frame[a][1] * sample[1] + (int32_t) frame[a][2] * sample[2];
+  }
+  for (uint8_t a = 0; a < 3; a++) {
+    // Rounding to the nearest rather than towards minus infinity
+    sample[a] = (int16_t) ((rotated[a] + ((int32_t) 1 << (orientation_shift - 1))) >> orientation_shift);
+  }
+}
+
+#ifdef GESTURE_TABLES_LEN
+static_assert(GESTURE_TABLES_ORIENTATION == ORIENTATION_NORMALISE, "gesture_tables.h is out of date, rerun tools/template_builder.cpp");
+#endif
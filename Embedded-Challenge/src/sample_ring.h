@@ -0,0 +1,79 @@
+/*
+    A ring buffer of accelerometer samples between an interrupt, which pushes them, and the loop, which pops them. There
+    is a single producer and a single consumer, and each of them only moves its own index: the producer the head and the
+    consumer the tail. Both are single bytes, which the AVR reads and writes in one instruction, so the ring needs no
+    locking, and the interrupts never have to be disabled to use it.
+
+    This file has to be included after LIS3DH.h.
+*/
+
+#ifdef __has_include
+    #if __has_include(<Arduino.h>)
+        #include <Arduino.h>
+    #endif
+#endif
+
+/// @brief Ring buffer of N samples, N being a power of 2 of at most 128
+template <uint8_t N>
+class SampleRing {
+    static_assert(N > 0 && N <= 128 && (N & (N - 1)) == 0, "The size of a SampleRing has to be a power of 2 of at most 128");
+
+    private:
+    LIS3DHSample samples[N];
+    // Both indices run freely and wrap around at 256, head - tail is how many samples are in the ring
+    volatile uint8_t head = 0;
+    volatile uint8_t tail = 0;
+
+    public:
+
+    /// @brief Returns how many samples are in the ring
+    uint8_t size() {
+        return (uint8_t) (this->head - this->tail);
+    }
+
+    /*
+      Producer side. Returns where up to count samples can be written without wrapping around, and lowers count to how
+      many that is (0 if the ring is full). They are only handed over to the consumer by commit().
+    */
+    LIS3DHSample* reserve(uint8_t& count) {
+        const uint8_t start = this->head & (N - 1);
+        count = min(count, min((uint8_t) (N - size()), (uint8_t) (N - start)));
+        return &this->samples[start];
+    }
+
+    /// @brief Producer side, hands over the count samples written after reserve()
+    void commit(uint8_t count) {
+        // The samples have to be in memory before the consumer can see them
+        asm volatile("" ::: "memory");
+        this->head += count;
+    }
+
+    /// @brief Producer side, adds a sample, and returns false if the ring is full and it was dropped
+    bool push(const LIS3DHSample& sample) {
+        uint8_t count = 1;
+        LIS3DHSample* slot = reserve(count);
+        if (count == 0) {
+            return false;
+        }
+        *slot = sample;
+        commit(1);
+        return true;
+    }
+
+    /// @brief Consumer side, takes out the oldest sample, and returns false if the ring is empty
+    bool pop(LIS3DHSample& sample) {
+        if (this->head == this->tail) {
+            return false;
+        }
+        sample = this->samples[this->tail & (N - 1)];
+        // The sample has to be read before the producer can overwrite it
+        asm volatile("" ::: "memory");
+        this->tail++;
+        return true;
+    }
+
+    /// @brief Consumer side, drops every sample in the ring
+    void clear() {
+        this->tail = this->head;
+    }
+};
@@ -0,0 +1,708 @@
+/*
+    Generated by tools/template_builder.cpp from the recordings in gestures.h, don't edit by hand. The tables
+    depend on the recordings and on the DTW options, so the builder has to be rerun whenever either changes.
+*/
+
+#ifdef __has_include
+    #if __has_include(<Arduino.h>)
+        #include <Arduino.h>
+    #endif
+#endif
+
+#define GESTURE_TABLES_LEN 20
+#define GESTURE_TABLES_WINDOW 1
+#define GESTURE_TABLES_RADIUS 4
+#define GESTURE_TABLES_COARSE_LEN 10
+#define GESTURE_TABLES_CENTROIDS 1
+#define GESTURE_TABLES_ORIENTATION 0
+#define GESTURE_TABLES_KERNEL 1
+#define GESTURE_TABLES_COST 5
+#define GESTURE_TABLES_SAX_SEGMENTS 10
+#define GESTURE_TABLES_SAX_ALPHABET 16
+#define GESTURE_TABLES_PACKED 1
+
+// DBA centroids, one per gesture, averaged from all of its recordings in gestures.h
+const int8_t PROGMEM centroid0[] = {
+    63, -26, 90,
+    79, -60, 87,
+    119, 19, 70,
+    49, 87, 60,
+    -72, 93, 48,
+    -118, 86, 50,
+    -98, 43, 66,
+    -40, -118, 56,
+    50, -76, 30,
+    -33, 2, -3,
+    -108, 84, -46,
+    -62, 118, -85,
+    12, 61, -90,
+    12, -29, -52,
+    -17, -22, 4,
+    -17, 17, 30,
+    1, 13, 34,
+    37, 3, 39,
+    48, -3, 44,
+    49, -2, 45,
+    47, -2, 46,
+};
+
+const int8_t PROGMEM centroid1[] = {
+    36, 1, 65,
+    41, 3, 63,
+    61, 23, 60,
+    48, 46, 55,
+    8, 37, 56,
+    -35, -9, 49,
+    -32, -106, 70,
+    44, -114, 33,
+    90, -34, -18,
+    76, -9, -7,
+    -2, -48, 31,
+    -70, -20, 48,
+    -89, 53, 7,
+    -67, 111, -35,
+    -28, 114, -70,
+    -4, 58, -60,
+    -19, -11, 4,
+    -6, -30, 45,
+    19, -16, 44,
+    22, -11, 43,
+};
+
+const int8_t PROGMEM centroid2[] = {
+    31, -25, 86,
+    37, -24, 81,
+    57, -5, 90,
+    65, 46, 106,
+    20, -8, 119,
+    -12, -31, 103,
+    -32, 6, 111,
+    -65, 20, 54,
+    8, 43, 24,
+    64, 29, -27,
+    53, -2, -82,
+    61, 44, -120,
+    63, 46, -70,
+    -12, 1, 27,
+    -34, -48, 61,
+    -18, -28, 92,
+    -51, -3, 41,
+    -43, 1, 42,
+    16, 28, 24,
+    35, 49, -13,
+};
+
+const int8_t PROGMEM centroid3[] = {
+    48, -81, 112,
+    48, -62, 115,
+    11, -61, 115,
+    -28, -48, 73,
+    10, -12, -11,
+    61, 20, -53,
+    47, 32, -56,
+    83, 78, -70,
+    20, 23, -18,
+    -35, -35, 52,
+    -17, -36, 70,
+    -47, -20, 91,
+    -83, 40, 85,
+    16, 70, -44,
+    29, 33, -81,
+    25, 60, -88,
+    75, 91, -116,
+    2, 6, -54,
+    -48, -85, 36,
+    -21, -91, 93,
+};
+
+const int8_t PROGMEM centroid4[] = {
+    63, -20, 110,
+    47, 9, 103,
+    7, 23, 99,
+    -21, 38, 104,
+    -81, -11, 68,
+    16, -82, 17,
+    82, -34, -75,
+    58, 35, -111,
+    32, 66, -110,
+    28, 76, -108,
+    -20, 82, -81,
+    -63, 65, -47,
+    -62, 7, 8,
+    -5, -64, 69,
+    59, -76, 93,
+    78, -56, 98,
+    80, -45, 102,
+    78, -41, 99,
+    81, -40, 94,
+    75, -30, 98,
+};
+
+const int8_t PROGMEM centroid5[] = {
+    79, -7, 15,
+    80, -7, 15,
+    74, -7, 15,
+    74, -11, 12,
+    78, -26, 23,
+    51, 3, 122,
+    -80, 27, -32,
+    -43, -8, -121,
+    25, 5, -65,
+    67, 10, -44,
+    63, 18, -40,
+    66, 2, -38,
+    65, 1, -38,
+    64, 5, -38,
+    67, 1, -38,
+    62, 1, -33,
+    76, -15, -30,
+    76, -13, -34,
+    81, -5, -37,
+    80, -9, -34,
+};
+
+const int8_t PROGMEM centroid6[] = {
+    107, 16, 105,
+    102, 26, 99,
+    91, 39, 97,
+    43, 38, 58,
+    39, -49, 28,
+    39, -112, -4,
+    -64, -60, -48,
+    -105, 61, -87,
+    -70, 112, -62,
+    -107, 72, -105,
+    -66, -46, -39,
+    35, -79, 24,
+    49, -102, 40,
+    -29, -56, 11,
+    -60, 40, -19,
+    -24, 68, -27,
+    6, 46, 0,
+    21, 45, 4,
+    27, 44, 3,
+    31, 44, 4,
+};
+
+const int8_t PROGMEM centroid7[] = {
+    97, 84, 105,
+    98, 83, 105,
+    106, 87, 109,
+    114, 92, 125,
+    46, 81, 97,
+    -32, 46, 76,
+    -83, -33, -30,
+    -21, -92, -121,
+    77, -41, -82,
+    66, 19, 39,
+    17, 73, 72,
+    -48, 72, 43,
+    -114, 34, 3,
+    -107, -28, -95,
+    -76, -32, -125,
+    17, 13, -108,
+    52, 43, -33,
+    53, 60, 20,
+    75, 60, 40,
+    96, 73, 53,
+};
+
+const int8_t PROGMEM centroid8[] = {
+    56, 1, 78,
+    58, 2, 76,
+    51, -8, 76,
+    66, -37, 42,
+    40, 1, -35,
+    -45, 103, 3,
+    -65, 38, 67,
+    27, -77, 40,
+    56, -68, -44,
+    -3, 44, -95,
+    -21, 103, -9,
+    -39, 20, 95,
+    37, -103, 45,
+    44, -78, -52,
+    28, 10, -87,
+    24, 92, -21,
+    -7, 92, 33,
+    19, -9, 75,
+    30, -33, 58,
+    37, 18, 34,
+};
+
+const int8_t PROGMEM centroid9[] = {
+    19, 17, 76,
+    20, 19, 80,
+    45, 49, 74,
+    52, 94, 100,
+    -1, -4, 74,
+    -31, -44, 95,
+    -65, 25, 68,
+    -53, 62, 66,
+    55, -24, -11,
+    65, -77, -88,
+    33, -116, -100,
+    3, -68, -81,
+    -10, 117, -68,
+    12, 92, 11,
+    12, 43, 11,
+    14, 35, 7,
+    15, 34, 5,
+    15, 34, 5,
+    15, 34, 5,
+    20, -13, 3,
+};
+
+const PackedGestureDescriptor PROGMEM gesture_centroids[] = {
+    { centroid0, {421, 97, -219}, {1, 2, 2}, 21, 0, 0 },
+    { centroid1, {377, 120, -314}, {2, 2, 2}, 20, 1, 0 },
+    { centroid2, {416, 90, -211}, {2, 1, 1}, 20, 2, 0 },
+    { centroid3, {386, 86, -274}, {2, 1, 2}, 20, 3, 0 },
+    { centroid4, {387, 225, -131}, {1, 2, 2}, 20, 4, 0 },
+    { centroid5, {399, 121, 32}, {1, 1, 4}, 20, 5, 0 },
+    { centroid6, {36, 58, -269}, {4, 8, 3}, 20, 6, 0 },
+    { centroid7, {92, -103, -202}, {4, 2, 3}, 20, 7, 0 },
+    { centroid8, {430, 48, -141}, {1, 4, 3}, 20, 8, 0 },
+    { centroid9, {440, 63, -127}, {2, 2, 1}, 20, 9, 0 }
+};
+
+// LB_Keogh envelopes, one { upper x, upper y, upper z, lower x, lower y, lower z } entry per query sample
+const int16_t PROGMEM centroid0_envelope[] = {
+    540, 283, -39, 349, -23, -123,
+    540, 283, -39, 303, -23, -123,
+    540, 283, -39, 303, -23, -123,
+    540, 283, -39, 303, -139, -123,
+    540, 283, -39, 303, -139, -159,
+    540, 283, -45, 303, -139, -225,
+    540, 283, -79, 303, -139, -311,
+    471, 333, -87, 303, -139, -389,
+    471, 333, -87, 303, -139, -399,
+    471, 333, -87, 303, -139, -399,
+    471, 333, -107, 313, -139, -399,
+    471, 333, -151, 313, -55, -399,
+    458, 333, -141, 313, 39, -399,
+    469, 333, -131, 313, 39, -399,
+    470, 333, -129, 359, 39, -399,
+    470, 219, -127, 404, 39, -399,
+    470, 131, -127, 404, 39, -323,
+    470, 131, -127, 404, 53, -211,
+    470, 131, -127, 404, 91, -159,
+    470, 123, -127, 422, 91, -151,
+};
+
+const int16_t PROGMEM centroid1_envelope[] = {
+    499, 212, -184, 393, 122, -204,
+    499, 212, -184, 307, 102, -216,
+    499, 212, -174, 307, -92, -216,
+    499, 212, -174, 307, -108, -248,
+    557, 212, -174, 307, -108, -350,
+    557, 212, -174, 307, -108, -350,
+    557, 212, -174, 307, -108, -350,
+    557, 212, -174, 237, -108, -350,
+    557, 226, -174, 199, -108, -350,
+    557, 342, -174, 199, -108, -384,
+    557, 348, -174, 199, -108, -454,
+    557, 348, -218, 199, -108, -454,
+    557, 348, -218, 199, 24, -454,
+    529, 348, -218, 199, 24, -454,
+    415, 348, -218, 199, 24, -454,
+    421, 348, -218, 199, 60, -454,
+    421, 348, -224, 199, 60, -454,
+    421, 348, -224, 243, 60, -454,
+    421, 348, -224, 321, 60, -454,
+    421, 236, -224, 339, 60, -434,
+};
+
+const int16_t PROGMEM centroid2_envelope[] = {
+    546, 136, -92, 456, 65, -130,
+    546, 136, -92, 392, 59, -130,
+    546, 136, -92, 352, 59, -130,
+    546, 136, -92, 286, 59, -157,
+    546, 136, -92, 286, 59, -187,
+    546, 136, -92, 286, 59, -238,
+    546, 136, -92, 286, 59, -293,
+    546, 136, -92, 286, 59, -331,
+    544, 136, -92, 286, 59, -331,
+    544, 136, -100, 286, 59, -331,
+    544, 136, -100, 286, 42, -331,
+    544, 136, -119, 286, 42, -331,
+    544, 136, -119, 314, 42, -331,
+    544, 136, -119, 314, 42, -331,
+    542, 136, -119, 314, 42, -331,
+    542, 139, -119, 314, 42, -331,
+    542, 139, -119, 314, 42, -281,
+    486, 139, -119, 314, 42, -224,
+    486, 139, -119, 314, 42, -224,
+    486, 139, -119, 314, 62, -224,
+};
+
+const int16_t PROGMEM centroid3_envelope[] = {
+    482, 74, -44, 330, 5, -296,
+    508, 106, -44, 330, 5, -380,
+    508, 118, -44, 330, 5, -386,
+    552, 164, -44, 330, 5, -414,
+    552, 164, -44, 330, 5, -414,
+    552, 164, -44, 316, 24, -414,
+    552, 164, -44, 316, 25, -414,
+    552, 164, -92, 292, 38, -414,
+    552, 164, -92, 220, 50, -414,
+    552, 164, -92, 220, 50, -414,
+    552, 164, -92, 220, 50, -436,
+    552, 164, -92, 220, 50, -450,
+    536, 177, -92, 220, 50, -506,
+    536, 177, -92, 220, 50, -506,
+    536, 177, -92, 220, 1, -506,
+    536, 177, -88, 220, -5, -506,
+    536, 177, -88, 220, -5, -506,
+    536, 177, -88, 290, -5, -506,
+    536, 177, -88, 290, -5, -506,
+    536, 177, -88, 290, -5, -506,
+};
+
+const int16_t PROGMEM centroid4_envelope[] = {
+    450, 301, 89, 306, 185, 5,
+    450, 301, 89, 306, 61, -97,
+    469, 301, 89, 306, 61, -281,
+    469, 301, 89, 306, 61, -353,
+    469, 357, 89, 306, 61, -353,
+    469, 377, 77, 306, 61, -353,
+    469, 389, 77, 306, 61, -353,
+    469, 389, 77, 306, 61, -353,
+    469, 389, 5, 306, 61, -353,
+    469, 389, 7, 324, 61, -353,
+    469, 389, 55, 324, 73, -353,
+    465, 389, 65, 324, 73, -353,
+    467, 389, 73, 324, 73, -351,
+    467, 389, 73, 324, 73, -347,
+    468, 389, 73, 324, 73, -293,
+    468, 355, 73, 324, 73, -225,
+    468, 239, 73, 325, 73, -115,
+    468, 165, 73, 382, 73, 7,
+    468, 165, 73, 446, 73, 55,
+    468, 165, 73, 462, 113, 57,
+};
+
+const int16_t PROGMEM centroid5_envelope[] = {
+    479, 114, 124, 473, 95, 80,
+    479, 124, 520, 450, 95, 80,
+    479, 148, 520, 319, 95, -96,
+    479, 148, 520, 319, 95, -452,
+    479, 148, 520, 319, 95, -452,
+    479, 148, 520, 319, 95, -452,
+    477, 148, 520, 319, 95, -452,
+    477, 148, 520, 319, 95, -452,
+    477, 148, 520, 319, 95, -452,
+    466, 148, 520, 319, 113, -452,
+    466, 148, -96, 319, 113, -452,
+    466, 139, -100, 356, 113, -452,
+    475, 139, -88, 424, 106, -228,
+    475, 139, -88, 461, 106, -144,
+    480, 139, -88, 461, 106, -128,
+    480, 126, -88, 461, 106, -120,
+    480, 126, -88, 461, 106, -120,
+    480, 126, -88, 461, 106, -120,
+    480, 122, -88, 461, 106, -120,
+    480, 122, -88, 461, 106, -116,
+};
+
+const int16_t PROGMEM centroid6_envelope[] = {
+    464, 370, 46, 192, -334, -185,
+    464, 370, 46, 192, -838, -281,
+    464, 370, 46, -220, -838, -413,
+    464, 546, 46, -384, -838, -530,
+    464, 954, 46, -384, -838, -530,
+    444, 954, 28, -392, -838, -584,
+    400, 954, 22, -392, -838, -584,
+    208, 954, -95, -392, -838, -584,
+    232, 954, -149, -392, -838, -584,
+    232, 954, -149, -392, -838, -584,
+    232, 954, -149, -392, -758, -584,
+    232, 954, -149, -392, -758, -584,
+    232, 954, -149, -392, -758, -584,
+    232, 634, -149, -392, -758, -584,
+    232, 602, -149, -228, -758, -386,
+    232, 602, -149, -204, -758, -350,
+    232, 602, -149, -204, -758, -350,
+    160, 602, -236, -204, -390, -350,
+    160, 602, -257, -204, 378, -350,
+    160, 602, -257, -60, 410, -350,
+};
+
+const int16_t PROGMEM centroid7_envelope[] = {
+    548, 81, 173, 276, 59, 89,
+    548, 81, 173, -36, -11, 26,
+    548, 81, 173, -240, -169, -292,
+    548, 81, 173, -240, -287, -565,
+    548, 81, 173, -240, -287, -565,
+    548, 81, 173, -240, -287, -565,
+    548, 81, 173, -240, -287, -565,
+    548, 81, 173, -240, -287, -565,
+    400, 59, 89, -364, -287, -565,
+    400, 43, 26, -364, -287, -565,
+    400, 43, 14, -364, -287, -577,
+    400, 43, 14, -364, -287, -577,
+    400, 43, 14, -364, -185, -577,
+    356, 43, 14, -364, -167, -577,
+    392, 43, 14, -364, -167, -577,
+    476, 43, -43, -364, -167, -577,
+    476, 43, -43, -364, -167, -577,
+    476, 43, -43, -336, -167, -577,
+    476, 43, -43, -212, -167, -577,
+    476, 43, -43, 160, -77, -526,
+};
+
+const int16_t PROGMEM centroid8_envelope[] = {
+    496, 56, 93, 470, -100, -246,
+    496, 460, 93, 385, -100, -246,
+    496, 460, 93, 365, -100, -246,
+    496, 460, 93, 365, -260, -246,
+    496, 460, 93, 365, -260, -273,
+    496, 460, 87, 365, -260, -426,
+    496, 460, 87, 365, -260, -426,
+    496, 460, 144, 365, -260, -426,
+    486, 460, 144, 365, -364, -426,
+    486, 460, 144, 365, -364, -426,
+    486, 460, 144, 365, -364, -426,
+    486, 460, 144, 391, -364, -426,
+    486, 460, 144, 391, -364, -426,
+    474, 460, 144, 391, -364, -426,
+    474, 460, 144, 391, -364, -402,
+    474, 416, 144, 391, -364, -402,
+    474, 416, 84, 423, -364, -402,
+    474, 416, 84, 423, -264, -402,
+    467, 416, 84, 423, -84, -402,
+    467, 416, 84, 423, -84, -204,
+};
+
+const int16_t PROGMEM centroid9_envelope[] = {
+    544, 251, -27, 438, 55, -53,
+    544, 251, -27, 378, -25, -53,
+    544, 251, -27, 310, -25, -59,
+    544, 251, -27, 310, -25, -61,
+    550, 251, -27, 310, -25, -138,
+    570, 251, -27, 310, -91, -215,
+    570, 251, -27, 310, -169, -227,
+    570, 251, -27, 310, -169, -227,
+    570, 297, -32, 310, -169, -227,
+    570, 297, -32, 310, -169, -227,
+    570, 297, -59, 310, -169, -227,
+    570, 297, -61, 334, -169, -227,
+    570, 297, -116, 420, -169, -227,
+    570, 297, -116, 420, -169, -227,
+    506, 297, -116, 420, -169, -227,
+    480, 297, -116, 420, -73, -208,
+    480, 297, -116, 420, 37, -195,
+    480, 247, -116, 464, 37, -124,
+    480, 149, -116, 464, 37, -124,
+    480, 133, -120, 468, 37, -124,
+};
+
+const int16_t* const PROGMEM gesture_envelopes[] = {
+    centroid0_envelope,
+    centroid1_envelope,
+    centroid2_envelope,
+    centroid3_envelope,
+    centroid4_envelope,
+    centroid5_envelope,
+    centroid6_envelope,
+    centroid7_envelope,
+    centroid8_envelope,
+    centroid9_envelope
+};
+
+// Recordings averaged down to 10 samples for the coarse pass of the multi-resolution DTW
+const int16_t PROGMEM centroid0_coarse[] = {
+    492, 11, -42,
+    505, 203, -89,
+    326, 276, -121,
+    352, 22, -97,
+    429, 23, -192,
+    336, 299, -350,
+    433, 129, -361,
+    404, 92, -185,
+    440, 113, -146,
+    469, 92, -129,
+};
+
+const int16_t PROGMEM centroid1_coarse[] = {
+    454, 124, -186,
+    486, 189, -199,
+    350, 148, -209,
+    389, -100, -211,
+    543, 77, -339,
+    305, 52, -235,
+    221, 284, -342,
+    345, 292, -444,
+    352, 79, -265,
+    418, 93, -227,
+};
+
+const int16_t PROGMEM centroid2_coarse[] = {
+    484, 65, -127,
+    538, 110, -113,
+    424, 70, -100,
+    319, 103, -128,
+    488, 126, -212,
+    530, 111, -312,
+    467, 113, -232,
+    364, 52, -134,
+    322, 89, -169,
+    467, 128, -205,
+};
+
+const int16_t PROGMEM centroid3_coarse[] = {
+    482, 14, -47,
+    369, 31, -86,
+    457, 90, -338,
+    516, 141, -400,
+    371, 80, -240,
+    322, 58, -113,
+    319, 141, -233,
+    440, 132, -443,
+    463, 134, -444,
+    317, -2, -145,
+};
+
+const int16_t PROGMEM centroid4_coarse[] = {
+    442, 214, 82,
+    380, 286, 72,
+    354, 132, -46,
+    457, 226, -317,
+    417, 367, -349,
+    345, 372, -259,
+    353, 168, -54,
+    455, 93, 60,
+    466, 139, 70,
+    465, 155, 61,
+};
+
+const int16_t PROGMEM centroid5_coarse[] = {
+    478, 114, 92,
+    473, 112, 86,
+    463, 109, 322,
+    337, 130, -274,
+    445, 128, -186,
+    463, 131, -124,
+    463, 124, -120,
+    463, 122, -110,
+    475, 107, -96,
+    479, 114, -110,
+};
+
+const int16_t PROGMEM centroid6_coarse[] = {
+    454, 226, 37,
+    304, 366, -36,
+    192, -586, -233,
+    -302, 62, -471,
+    -318, 794, -519,
+    -26, -442, -291,
+    76, -574, -192,
+    -132, 490, -338,
+    90, 422, -263,
+    152, 410, -258,
+};
+
+const int16_t PROGMEM centroid7_coarse[] = {
+    482, 64, 113,
+    532, 76, 149,
+    120, 24, 57,
+    -116, -228, -428,
+    378, -125, -266,
+    30, 42, -29,
+    -350, -97, -340,
+    -26, -122, -551,
+    302, 0, -221,
+    434, 30, -62,
+};
+
+const int16_t PROGMEM centroid8_coarse[] = {
+    487, 54, 90,
+    488, -42, 36,
+    427, 256, -189,
+    411, -30, 19,
+    456, 0, -349,
+    400, 294, -12,
+    470, -314, -151,
+    456, 252, -303,
+    436, 214, 21,
+    463, 18, -3,
+};
+
+const int16_t PROGMEM centroid9_coarse[] = {
+    479, 99, -49,
+    537, 206, -40,
+    408, 15, -42,
+    322, 150, -60,
+    560, -38, -176,
+    476, -121, -217,
+    442, 272, -155,
+    466, 141, -118,
+    470, 131, -122,
+    475, 84, -123,
+};
+
+const int16_t* const PROGMEM gesture_coarse[] = {
+    centroid0_coarse,
+    centroid1_coarse,
+    centroid2_coarse,
+    centroid3_coarse,
+    centroid4_coarse,
+    centroid5_coarse,
+    centroid6_coarse,
+    centroid7_coarse,
+    centroid8_coarse,
+    centroid9_coarse
+};
+
+// Summary features, { mean, min, max, energy, crossings } for each axis (see dtw_features in dtw.h)
+const int16_t PROGMEM gesture_features[][15] = {
+    {421, 124, -169, 303, -139, -399, 540, 333, -39, 53, 92, 80, 5, 5, 1},
+    {386, 123, -265, 199, -108, -454, 557, 348, -174, 79, 85, 69, 4, 4, 4},
+    {440, 96, -173, 286, 42, -331, 546, 139, -92, 73, 24, 53, 4, 7, 3},
+    {405, 82, -248, 220, -5, -506, 552, 177, -44, 71, 49, 143, 5, 4, 4},
+    {413, 215, -68, 306, 61, -353, 469, 389, 89, 44, 89, 151, 4, 4, 2},
+    {454, 119, -52, 319, 95, -452, 480, 148, 520, 26, 9, 131, 2, 4, 1},
+    {49, 116, -256, -392, -838, -584, 464, 954, 46, 220, 444, 128, 4, 4, 3},
+    {178, -33, -158, -364, -287, -577, 548, 81, 173, 256, 87, 212, 4, 4, 4},
+    {449, 70, -84, 365, -364, -426, 496, 460, 144, 30, 188, 147, 6, 7, 6},
+    {463, 93, -110, 310, -169, -227, 570, 297, -27, 45, 91, 50, 4, 5, 1}
+};
+
+// Largest normalised DTW distance accepted for each template (see template_threshold in dtw.h)
+const uint16_t PROGMEM gesture_thresholds[] = {
+    5703,
+    6048,
+    5679,
+    4881,
+    3744,
+    2949,
+    9309,
+    5001,
+    7986,
+    6135
+};
+
+// SAX breakpoints, DTW_SAX_ALPHABET - 1 for each axis (see dtw_sax_symbol in dtw.h)
+const int16_t PROGMEM gesture_sax_breakpoints[][15] = {
+    {-54, 223, 302, 334, 364, 385, 411, 433, 449, 460, 472, 476, 482, 492, 526},
+    {-211, -60, -1, 28, 56, 73, 89, 105, 115, 130, 148, 164, 224, 303, 386},
+    {-440, -376, -302, -259, -222, -200, -179, -131, -123, -102, -81, -55, -12, 51, 93}
+};
+
+// SAX words of the buckets, { lo | hi << 4 } for each segment and axis
+const uint8_t PROGMEM gesture_sax_words[][30] = {
+    {0xF3, 0xD2, 0xC9, 0xF3, 0xD1, 0xC9, 0xF3, 0xD1, 0xC4, 0xF3, 0xE1, 0xB1, 0xA3, 0xE1, 0xA1, 0xA3, 0xE1, 0x91, 0xA3, 0xE4, 0x81, 0xA4, 0xE4, 0x81, 0xA6, 0xA4, 0x82, 0xA6, 0xA7, 0x87},
+    {0xE3, 0xC7, 0x65, 0xE3, 0xC1, 0x74, 0xF3, 0xC1, 0x72, 0xF2, 0xC1, 0x72, 0xF1, 0xE1, 0x71, 0xF1, 0xE1, 0x70, 0xF1, 0xE3, 0x50, 0x71, 0xE3, 0x50, 0x71, 0xE5, 0x40, 0x73, 0xE5, 0x40},
+    {0xF6, 0xA5, 0xA8, 0xF2, 0xA5, 0xA7, 0xF2, 0xA5, 0xA4, 0xF2, 0xA5, 0xA2, 0xF2, 0xA5, 0xA2, 0xF2, 0xA4, 0xA2, 0xF3, 0xA4, 0x92, 0xF3, 0xA4, 0x92, 0xF3, 0xA4, 0x93, 0xD3, 0xA4, 0x94},
+    {0xE3, 0x83, 0xC1, 0xF3, 0xC3, 0xC1, 0xF3, 0xC3, 0xC1, 0xF2, 0xC3, 0xC1, 0xF1, 0xC4, 0xA1, 0xF1, 0xC4, 0xA0, 0xF1, 0xC4, 0xA0, 0xF1, 0xC2, 0xA0, 0xF1, 0xC2, 0xA0, 0xF2, 0xC2, 0xA0},
+    {0x93, 0xD5, 0xEA, 0xA3, 0xD5, 0xE2, 0xA3, 0xE5, 0xE2, 0xA3, 0xF5, 0xE2, 0xA3, 0xF5, 0xD2, 0xA3, 0xF6, 0xE2, 0xA3, 0xF6, 0xE2, 0xA3, 0xF6, 0xE3, 0xA3, 0xD6, 0xE9, 0xA8, 0xC6, 0xEE},
+    {0xC9, 0x97, 0xFE, 0xC3, 0xB7, 0xF0, 0xC3, 0xB7, 0xF0, 0xC3, 0xB7, 0xF0, 0xC3, 0xB7, 0xF0, 0xA3, 0xB8, 0xA0, 0xB7, 0xA8, 0xA4, 0xCA, 0xA8, 0xA8, 0xCA, 0x98, 0xA9, 0xCA, 0x98, 0xA9},
+    {0xA1, 0xE0, 0xD3, 0xA0, 0xF0, 0xD0, 0xA0, 0xF0, 0xD0, 0x60, 0xF0, 0xD0, 0x20, 0xF0, 0x70, 0x20, 0xF0, 0x70, 0x20, 0xF0, 0x70, 0x20, 0xF0, 0x71, 0x20, 0xF0, 0x72, 0x10, 0xFE, 0x42},
+    {0xF1, 0x62, 0xFD, 0xF0, 0x60, 0xF0, 0xF0, 0x60, 0xF0, 0xF0, 0x60, 0xF0, 0x60, 0x50, 0xE0, 0x60, 0x40, 0xD0, 0x60, 0x41, 0xD0, 0xC0, 0x41, 0xD0, 0xC0, 0x41, 0xC0, 0xC0, 0x41, 0xC0},
+    {0xE6, 0xF1, 0xF4, 0xE5, 0xF0, 0xF4, 0xE5, 0xF0, 0xF1, 0xE5, 0xF0, 0xF1, 0xD5, 0xF0, 0xF1, 0xD5, 0xF0, 0xF1, 0xD6, 0xF0, 0xF1, 0xB6, 0xF0, 0xF1, 0xB7, 0xF0, 0xE1, 0xA7, 0xF1, 0xE1},
+    {0xF5, 0xD2, 0xCC, 0xF3, 0xD2, 0xCB, 0xF3, 0xD1, 0xC5, 0xF3, 0xD1, 0xC4, 0xF3, 0xD1, 0xC4, 0xF3, 0xD1, 0xB4, 0xF7, 0xD1, 0x94, 0xE7, 0xD1, 0x94, 0xC7, 0xD4, 0x96, 0xCA, 0xB4, 0x98}
+};
+
+// The templates of bucket b are gesture_sax_members[gesture_sax_bucket_starts[b]] up to the start of bucket b + 1
+const uint8_t PROGMEM gesture_sax_bucket_starts[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+const uint8_t PROGMEM gesture_sax_members[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
@@ -0,0 +1,134 @@
+/*
+    Checks the assembly row update of dtw_asm.h against dtw_row_reference() on a simulated atmega32u4, run with
+    `pio test -e simavr`. Every row of every template is updated by both from the same band, against random query
+    samples and against samples at the ends of the accelerometer's range, from bands whose cells are random or at and
+    just under DTW_INFINITY, so that the saturating additions are taken too.
+
+    The templates are stored packed, so the test has its own gesture_tables.h, built from the Embedded-Challenge
+    directory with:
+        g++ -std=c++11 -O2 -DDTW_PACKED_TEMPLATES=1 -DDTW_COST=DTW_COST_NARROW_L1 -o template_builder tools/template_builder.cpp
+        ./template_builder > test/test_embedded_dtw_asm/gesture_tables.h
+*/
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+#include <avr/sleep.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unity.h>
+
+// Minimal stand-ins for the Arduino functionalities used by the shared headers, the test is built without the framework
+#ifndef min
+#define min(a, b) ((a) < (b) ? (a) : (b))
+#endif
+#ifndef max
+#define max(a, b) ((a) > (b) ? (a) : (b))
+#endif
+
+#include "../../src/gestures.h"
+#include "gesture_tables.h"
+
+const uint8_t collecter_size = 20;
+
+#include "../../src/dtw.h"
+
+#ifndef DTW_ASM_ROW
+#error "The assembly isn't built, the simavr environment has to set DTW_ASM_KERNEL, DTW_PACKED_TEMPLATES and DTW_COST_NARROW_L1"
+#endif
+
+/// @brief A random acceleration on one axis, within the 12 bits of the accelerometer or at one of their ends
+int16_t random_sample(bool extreme) {
+  if (extreme) {
+    return (random() & 1) ? 2047 : -2048;
+  }
+  return (int16_t) (random() % 4096) - 2048;
+}
+
+/// @brief A random cell, unreachable, just under DTW_INFINITY, anywhere in the 16 bits or as small as a real cell
+uint16_t random_cell(bool saturating) {
+  switch (random() % (saturating ? 2 : 4)) {
+    case 0:
+      return DTW_INFINITY;
+    case 1:
+      return DTW_INFINITY - 1 - random() % 4096;
+    case 2:
+      return (uint16_t) random();
+    default:
+      return random() % 4096;
+  }
+}
+
+/// @brief Updates the row i of the template t with both dtw_row_reference() and the assembly, and compares them
+void check_row(uint8_t t, uint8_t i, bool extreme) {
+  static dtw_cost_t reference_band[dtw_band_size];
+  static dtw_cost_t asm_band[dtw_band_size];
+  char message[32];
+  snprintf(message, sizeof(message), "template %d row %d", t, i);
+
+  const uint8_t m = template_length(t);
+  uint8_t lo, hi;
+  dtw_window(i, m, lo, hi);
+  const uint8_t c = dtw_center(i, m);
+  const uint8_t shift = (i > 0) ? c - dtw_center(i - 1, m) : 1;
+  const uint8_t first = dtw_radius + 1 - c + lo; // Where the cell (i, lo) is in the band
+  const uint8_t count = hi - lo + 1;
+
+  for (uint8_t k = 0; k < dtw_band_size; k++) {
+    reference_band[k] = random_cell(extreme);
+  }
+  memcpy(asm_band, reference_band, sizeof(asm_band));
+  const int16_t qx = random_sample(extreme);
+  const int16_t qy = random_sample(extreme);
+  const int16_t qz = random_sample(extreme);
+
+  GestureReader reference_reader(t, lo);
+  dtw_cost_t reference_min = dtw_row_reference<NarrowL1Metric>(reference_band + first, shift,
+                                                               reference_band[first + shift - 1], count,
+                                                               reference_reader, qx, qy, qz);
+  GestureReader asm_reader(t, lo);
+  dtw_cost_t asm_min = dtw_row<NarrowL1Metric>(asm_band + first, shift, asm_band[first + shift - 1], count, asm_reader,
+                                               qx, qy, qz);
+
+  TEST_ASSERT_EQUAL_UINT16_MESSAGE(reference_min, asm_min, message);
+  TEST_ASSERT_EQUAL_UINT16_ARRAY_MESSAGE(reference_band, asm_band, dtw_band_size, message);
+}
+
+/// @brief Random bands against random query samples
+void test_random_rows() {
+  srandom(1);
+  for (uint8_t round = 0; round < 8; round++) {
+    for (uint8_t t = 0; t < dtw_num_templates; t++) {
+      for (uint8_t i = 0; i < collecter_size; i++) {
+        check_row(t, i, false);
+      }
+    }
+  }
+}
+
+/// @brief Bands at or close to DTW_INFINITY against query samples at the ends of the range, the costs saturate
+void test_saturating_rows() {
+  srandom(2);
+  for (uint8_t round = 0; round < 8; round++) {
+    for (uint8_t t = 0; t < dtw_num_templates; t++) {
+      for (uint8_t i = 0; i < collecter_size; i++) {
+        check_row(t, i, true);
+      }
+    }
+  }
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_random_rows);
+  RUN_TEST(test_saturating_rows);
+  UNITY_END();
+  // simavr stops once the CPU sleeps with the interrupts off
+  cli();
+  sleep_enable();
+  sleep_cpu();
+  return 0;
+}
@@ -0,0 +1,150 @@
+/*
+    Host tests of the DTW engine against the centroids of src/gesture_tables.h, the templates the firmware matches by
+    default (DTW_CENTROIDS in tools/template_builder.cpp), run with `pio test -e native`. The queries are the
+    recordings of src/gestures.h.
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unity.h>
+
+// Minimal stand-ins for the Arduino functionalities used by the shared headers, as in tools/template_builder.cpp
+#define PROGMEM
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_ptr(addr) (*(void* const*)(addr))
+#define memcpy_P memcpy
+#ifndef min
+#define min(a, b) ((a) < (b) ? (a) : (b))
+#endif
+#ifndef max
+#define max(a, b) ((a) > (b) ? (a) : (b))
+#endif
+
+#include "../../src/gestures.h"
+#include "../../src/gesture_tables.h"
+
+const uint8_t collecter_size = 20;
+int16_t collecter[collecter_size][3];
+
+#include "../../src/dtw.h"
+
+static_assert(GESTURE_TABLES_CENTROIDS && !GESTURE_TABLES_ORIENTATION && !GESTURE_TABLES_PACKED,
+              "The test reads the int16_t centroids, rerun tools/template_builder.cpp with its default options");
+
+const uint8_t num_recordings = sizeof(gestures) / sizeof(gestures[0]);
+
+/// @brief The full DTW matrix over the window for any metric, normalised like calculate_DTW()
+template <class Metric>
+typename Metric::cost_t window_dtw(uint8_t t, const int16_t query[][3]) {
+  typedef typename Metric::cost_t cost_t;
+  static cost_t matrix[collecter_size][dtw_max_length];
+  const uint8_t m = template_length(t);
+  const int16_t* data = template_data(t);
+  for (uint8_t i = 0; i < collecter_size; i++) {
+    uint8_t lo, hi;
+    dtw_window(i, m, lo, hi);
+    for (uint8_t j = 0; j < m; j++) {
+      if (j < lo || j > hi) {
+        matrix[i][j] = Metric::infinity;
+        continue;
+      }
+      cost_t prev = 0;
+      if (i > 0 || j > 0) {
+        prev = Metric::infinity;
+        if (i > 0 && j > 0) {
+          prev = min(prev, matrix[i - 1][j - 1]);
+        }
+        if (i > 0) {
+          prev = min(prev, matrix[i - 1][j]);
+        }
+        if (j > 0) {
+          prev = min(prev, matrix[i][j - 1]);
+        }
+      }
+      const int16_t* sample = data + j * 3;
+      matrix[i][j] = dtw_add(Metric::match(sample[0], sample[1], sample[2], query[i][0], query[i][1], query[i][2]), prev);
+    }
+  }
+  return dtw_scale(matrix[collecter_size - 1][m - 1], 2 * collecter_size, collecter_size + m);
+}
+
+/// @brief Fills the query with a recording, padded with its last sample or cut to collecter_size samples
+void load_recording(uint8_t r) {
+  const uint8_t m = gestures[r].length;
+  const int16_t* data = gestures[r].data;
+  for (uint8_t i = 0; i < collecter_size; i++) {
+    for (uint8_t k = 0; k < 3; k++) {
+      collecter[i][k] = data[min(i, m - 1) * 3 + k];
+    }
+  }
+}
+
+/// @brief Returns the closest centroid with the engine's kernel
+uint8_t closest() {
+  dtw_cost_t best = DTW_INFINITY;
+  uint8_t chosen = dtw_unknown;
+  for (uint8_t t = 0; t < dtw_num_templates; t++) {
+    dtw_cost_t distance = calculate_DTW(t, collecter);
+    if (distance < best) {
+      best = distance;
+      chosen = t;
+    }
+  }
+  return chosen;
+}
+
+/// @brief Returns the closest centroid with the full matrix of a metric
+template <class Metric>
+uint8_t closest_with() {
+  typename Metric::cost_t best = Metric::infinity;
+  uint8_t chosen = dtw_unknown;
+  for (uint8_t t = 0; t < dtw_num_templates; t++) {
+    typename Metric::cost_t distance = window_dtw<Metric>(t, collecter);
+    if (distance < best) {
+      best = distance;
+      chosen = t;
+    }
+  }
+  return chosen;
+}
+
+/// @brief There is one centroid per gesture
+void test_one_centroid_per_gesture() {
+  TEST_ASSERT_EQUAL_UINT8(sizeof(gesture_names) / sizeof(gesture_names[0]), dtw_num_templates);
+  for (uint8_t t = 0; t < dtw_num_templates; t++) {
+    TEST_ASSERT_EQUAL_UINT8(t, template_label(t));
+  }
+}
+
+/// @brief The banded, early abandoning engine gives the distances of the full matrix against the centroids
+void test_engine_matches_full_matrix() {
+  for (uint8_t r = 0; r < num_recordings; r++) {
+    load_recording(r);
+    for (uint8_t t = 0; t < dtw_num_templates; t++) {
+      TEST_ASSERT_EQUAL_UINT32(window_dtw<DTWMetric>(t, collecter), calculate_DTW(t, collecter));
+    }
+  }
+}
+
+/// @brief Every recording is closest to the centroid of its own gesture, with the integer and the float kernels
+void test_recordings_pick_their_centroid() {
+  char message[48];
+  for (uint8_t r = 0; r < num_recordings; r++) {
+    load_recording(r);
+    snprintf(message, sizeof(message), "recording %d", r);
+    TEST_ASSERT_EQUAL_UINT8_MESSAGE(gestures[r].label, template_label(closest()), message);
+    TEST_ASSERT_EQUAL_UINT8_MESSAGE(gestures[r].label, template_label(closest_with<EuclideanMetric>()), message);
+  }
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_one_centroid_per_gesture);
+  RUN_TEST(test_engine_matches_full_matrix);
+  RUN_TEST(test_recordings_pick_their_centroid);
+  return UNITY_END();
+}
@@ -0,0 +1,175 @@
+/*
+    Host tests of the other classifiers of the engine against the batch cascade, run with `pio test -e native`. Every
+    recording of src/gestures.h is classified against the centroids of src/gesture_tables.h by the streaming DTW (with
+    and without the early decision), the interleaved sweep, the coarse-to-fine DTW and the time-sliced job, and each
+    has to pick the gesture the batch cascade picks. The shortlist and the SAX index change the candidates of every
+    classifier, so they have their own tests (test_native_shortlist, test_native_sax).
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unity.h>
+
+// Minimal stand-ins for the Arduino functionalities used by the shared headers, as in tools/template_builder.cpp
+#define PROGMEM
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_ptr(addr) (*(void* const*)(addr))
+#define memcpy_P memcpy
+#ifndef min
+#define min(a, b) ((a) < (b) ? (a) : (b))
+#endif
+#ifndef max
+#define max(a, b) ((a) > (b) ? (a) : (b))
+#endif
+#define F_CPU 8000000L
+
+/// @brief A clock that goes up by a microsecond every time it is read, so that a slice of the job only takes a few steps
+unsigned long micros() {
+  static unsigned long now = 0;
+  return now++;
+}
+
+#define DTW_STREAMING 1
+#define DTW_EARLY_DECISION 1
+
+#include "../../src/gestures.h"
+#include "../../src/gesture_tables.h"
+
+const uint8_t collecter_size = 20;
+int16_t collecter[collecter_size][3];
+
+#include "../../src/dtw.h"
+#include "../../src/dtw_multires.h"
+#include "../../src/dtw_job.h"
+
+const uint8_t num_recordings = sizeof(gestures) / sizeof(gestures[0]);
+
+/// @brief Fills the query with a recording, padded with its last sample or cut to collecter_size samples
+void load_recording(uint8_t r) {
+  const uint8_t m = gestures[r].length;
+  const int16_t* data = gestures[r].data;
+  for (uint8_t i = 0; i < collecter_size; i++) {
+    for (uint8_t k = 0; k < 3; k++) {
+      collecter[i][k] = data[min(i, m - 1) * 3 + k];
+    }
+  }
+}
+
+/*
+  The batch cascade of classify_cascade() without DTW_STREAMING: every template goes through the lower bounds and the DTW
+  bounded by the best distance so far. It is written out here since classify_cascade() reads the streamed distances in
+  this test.
+*/
+uint8_t classify_batch(const int16_t query[][3], dtw_cost_t& distance) {
+  uint8_t chosen = dtw_unknown;
+  distance = DTW_INFINITY;
+  for (uint8_t t = 0; t < dtw_num_templates; t++) {
+    dtw_cost_t curr = DTW_INFINITY;
+    const dtw_cost_t bound = template_bound(t, distance);
+    if (lb_kim(t, query) <= bound && lb_keogh(t, query, bound) <= bound) {
+      curr = template_accept(t, calculate_DTW(t, query, bound));
+    }
+    if (curr < distance) {
+      distance = curr;
+      chosen = t;
+    }
+  }
+  return chosen;
+}
+
+/// @brief The streamed distances are those of the batch cascade once the whole query went through
+void test_streaming_matches_batch() {
+  char message[48];
+  for (uint8_t r = 0; r < num_recordings; r++) {
+    load_recording(r);
+    snprintf(message, sizeof(message), "recording %d", r);
+    for (uint8_t i = 0; i < collecter_size; i++) {
+      dtw_stream_step(i, collecter[i]);
+    }
+    dtw_cost_t expected, distance;
+    const uint8_t batch = classify_batch(collecter, expected);
+    TEST_ASSERT_EQUAL_UINT8_MESSAGE(batch, classify_cascade(collecter, distance), message);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(expected, distance, message);
+  }
+}
+
+/// @brief When the streaming DTW decides early, it decides for the gesture the batch cascade picks
+void test_early_decision_matches_batch() {
+  char message[48];
+  uint8_t decided = 0;
+  for (uint8_t r = 0; r < num_recordings; r++) {
+    load_recording(r);
+    snprintf(message, sizeof(message), "recording %d", r);
+    dtw_cost_t distance;
+    const uint8_t batch = classify_batch(collecter, distance);
+    for (uint8_t i = 0; i < collecter_size; i++) {
+      dtw_stream_step(i, collecter[i]);
+      uint8_t chosen;
+      if (dtw_early_decision(i, chosen)) {
+        TEST_ASSERT_EQUAL_UINT8_MESSAGE(template_label(batch), template_label(chosen), message);
+        decided++;
+        break;
+      }
+    }
+  }
+  // Otherwise the test says nothing about the early decision
+  TEST_ASSERT_TRUE(decided > 0);
+}
+
+/// @brief The interleaved sweep gives the distances of the batch cascade
+void test_interleaved_matches_batch() {
+  char message[48];
+  for (uint8_t r = 0; r < num_recordings; r++) {
+    load_recording(r);
+    snprintf(message, sizeof(message), "recording %d", r);
+    dtw_cost_t expected, distance;
+    const uint8_t batch = classify_batch(collecter, expected);
+    TEST_ASSERT_EQUAL_UINT8_MESSAGE(batch, classify_interleaved(collecter, distance), message);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(expected, distance, message);
+  }
+}
+
+/// @brief The coarse-to-fine DTW picks the gesture of the batch cascade
+void test_multires_matches_batch() {
+  char message[48];
+  for (uint8_t r = 0; r < num_recordings; r++) {
+    load_recording(r);
+    snprintf(message, sizeof(message), "recording %d", r);
+    dtw_cost_t distance;
+    const uint8_t batch = classify_batch(collecter, distance);
+    TEST_ASSERT_EQUAL_UINT8_MESSAGE(template_label(batch), template_label(classify_multires(collecter, distance)), message);
+  }
+}
+
+/// @brief The time-sliced job, resumed over many short slices, ends on the template and distance of the batch cascade
+void test_time_sliced_job_matches_batch() {
+  char message[48];
+  for (uint8_t r = 0; r < num_recordings; r++) {
+    load_recording(r);
+    snprintf(message, sizeof(message), "recording %d", r);
+    dtw_cost_t expected;
+    const uint8_t batch = classify_batch(collecter, expected);
+    DTW_job.begin(collecter);
+    uint16_t slices = 1;
+    while (!DTW_job.run(4)) {
+      slices++;
+    }
+    TEST_ASSERT_TRUE_MESSAGE(slices > 1, message);
+    TEST_ASSERT_EQUAL_UINT8_MESSAGE(batch, DTW_job.result(), message);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(expected, DTW_job.distance(), message);
+  }
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_streaming_matches_batch);
+  RUN_TEST(test_early_decision_matches_batch);
+  RUN_TEST(test_interleaved_matches_batch);
+  RUN_TEST(test_multires_matches_batch);
+  RUN_TEST(test_time_sliced_job_matches_batch);
+  return UNITY_END();
+}
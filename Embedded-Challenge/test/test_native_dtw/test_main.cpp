@@ -0,0 +1,209 @@
+/*
+    Host tests of the integer DTW kernels, run with `pio test -e native`. The query and the templates are the recordings
+    of src/gestures.h, matched with the default options of dtw.h.
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unity.h>
+
+// Minimal stand-ins for the Arduino functionalities used by the shared headers, as in tools/template_builder.cpp
+#define PROGMEM
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_ptr(addr) (*(void* const*)(addr))
+#define memcpy_P memcpy
+#ifndef min
+#define min(a, b) ((a) < (b) ? (a) : (b))
+#endif
+#ifndef max
+#define max(a, b) ((a) > (b) ? (a) : (b))
+#endif
+
+#include "../../src/gestures.h"
+
+const uint8_t collecter_size = 20;
+int16_t collecter[collecter_size][3];
+
+#include "../../src/dtw.h"
+
+const uint8_t num_recordings = sizeof(gestures) / sizeof(gestures[0]);
+
+/// @brief The full DTW matrix over the window for any metric, normalised like calculate_DTW()
+template <class Metric>
+typename Metric::cost_t window_dtw(uint8_t t, const int16_t query[][3]) {
+  typedef typename Metric::cost_t cost_t;
+  static cost_t matrix[collecter_size][dtw_max_length];
+  const uint8_t m = template_length(t);
+  const int16_t* data = template_data(t);
+  for (uint8_t i = 0; i < collecter_size; i++) {
+    uint8_t lo, hi;
+    dtw_window(i, m, lo, hi);
+    for (uint8_t j = 0; j < m; j++) {
+      if (j < lo || j > hi) {
+        matrix[i][j] = Metric::infinity;
+        continue;
+      }
+      cost_t prev = 0;
+      if (i > 0 || j > 0) {
+        prev = Metric::infinity;
+        if (i > 0 && j > 0) {
+          prev = min(prev, matrix[i - 1][j - 1]);
+        }
+        if (i > 0) {
+          prev = min(prev, matrix[i - 1][j]);
+        }
+        if (j > 0) {
+          prev = min(prev, matrix[i][j - 1]);
+        }
+      }
+      const int16_t* sample = data + j * 3;
+      matrix[i][j] = dtw_add(Metric::match(sample[0], sample[1], sample[2], query[i][0], query[i][1], query[i][2]), prev);
+    }
+  }
+  return dtw_scale(matrix[collecter_size - 1][m - 1], 2 * collecter_size, collecter_size + m);
+}
+
+/// @brief Fills the query with a recording scaled by gain, padded with its last sample or cut to collecter_size samples
+void load_query(uint8_t r, float gain) {
+  const uint8_t m = template_length(r);
+  const int16_t* data = template_data(r);
+  for (uint8_t i = 0; i < collecter_size; i++) {
+    for (uint8_t k = 0; k < 3; k++) {
+      // The accelerometer reads 12 bits
+      collecter[i][k] = (int16_t) max(-2048L, min(2047L, lround(data[min(i, m - 1) * 3 + k] * gain)));
+    }
+  }
+}
+
+/// @brief Returns the closest template other than skip with the engine's kernel
+uint8_t closest(uint8_t skip) {
+  dtw_cost_t best = DTW_INFINITY;
+  uint8_t chosen = dtw_unknown;
+  for (uint8_t t = 0; t < dtw_num_templates; t++) {
+    dtw_cost_t distance = calculate_DTW(t, collecter);
+    if (t != skip && distance < best) {
+      best = distance;
+      chosen = t;
+    }
+  }
+  return chosen;
+}
+
+/// @brief Returns the closest template other than skip with the full matrix of a metric
+template <class Metric>
+uint8_t closest_with(uint8_t skip) {
+  typename Metric::cost_t best = Metric::infinity;
+  uint8_t chosen = dtw_unknown;
+  for (uint8_t t = 0; t < dtw_num_templates; t++) {
+    typename Metric::cost_t distance = window_dtw<Metric>(t, collecter);
+    if (t != skip && distance < best) {
+      best = distance;
+      chosen = t;
+    }
+  }
+  return chosen;
+}
+
+/// @brief The banded, early abandoning engine gives the distances of the full matrix
+void test_engine_matches_full_matrix() {
+  for (uint8_t r = 0; r < num_recordings; r++) {
+    load_query(r, 1);
+    for (uint8_t t = 0; t < dtw_num_templates; t++) {
+      TEST_ASSERT_EQUAL_UINT32(window_dtw<DTWMetric>(t, collecter), calculate_DTW(t, collecter));
+    }
+  }
+}
+
+/// @brief With every recording as the query, the closest other recording is the same for the integer and float kernels
+void test_integer_kernels_pick_the_float_winner() {
+  char message[48];
+  for (uint8_t r = 0; r < num_recordings; r++) {
+    load_query(r, 1);
+    const uint8_t expected = closest_with<EuclideanMetric>(r);
+    snprintf(message, sizeof(message), "recording %d", r);
+    TEST_ASSERT_EQUAL_UINT8_MESSAGE(expected, closest(r), message);
+    TEST_ASSERT_EQUAL_UINT8_MESSAGE(expected, closest_with<SquaredL2Metric>(r), message);
+  }
+}
+
+/// @brief No warping path can reach DTW_INFINITY with the L1 cost, even normalised against the shortest recording
+void test_l1_cannot_saturate() {
+  const uint32_t worst_cell = L1Metric::cost(-2048 - 2047, -2048 - 2047, -2048 - 2047);
+  TEST_ASSERT_EQUAL_UINT32(3 * 4095, worst_cell);
+  const uint32_t longest_path = worst_cell * (collecter_size + dtw_max_length - 1);
+  TEST_ASSERT_LESS_THAN_UINT32(L1Metric::infinity, longest_path * 2);
+}
+
+/*
+  A hard motion, four times as hard as a recording, saturates the uint16_t accumulator of NarrowL1Metric against some
+  of the recordings. The default L1Metric keeps every distance finite, so the motion is still matched to some recording
+  instead of coming out as unknown.
+*/
+void test_hard_motions_stay_finite() {
+  char message[48];
+  uint16_t saturated = 0;
+  for (uint8_t r = 0; r < num_recordings; r++) {
+    load_query(r, 4);
+    snprintf(message, sizeof(message), "recording %d scaled by 4", r);
+    for (uint8_t t = 0; t < dtw_num_templates; t++) {
+      saturated += window_dtw<NarrowL1Metric>(t, collecter) == NarrowL1Metric::infinity;
+      TEST_ASSERT_LESS_THAN_UINT32_MESSAGE(DTW_INFINITY, calculate_DTW(t, collecter), message);
+    }
+    TEST_ASSERT_NOT_EQUAL(dtw_unknown, closest(dtw_unknown));
+  }
+  TEST_ASSERT_TRUE(saturated > 0);
+
+  // Every axis at the opposite end of the range on every other sample
+  for (uint8_t i = 0; i < collecter_size; i++) {
+    for (uint8_t k = 0; k < 3; k++) {
+      collecter[i][k] = ((i + k) & 1) ? 2047 : -2048;
+    }
+  }
+  for (uint8_t t = 0; t < dtw_num_templates; t++) {
+    TEST_ASSERT_LESS_THAN_UINT32(DTW_INFINITY, calculate_DTW(t, collecter));
+  }
+  TEST_ASSERT_NOT_EQUAL(dtw_unknown, closest(dtw_unknown));
+}
+
+/// @brief The other integer metrics accumulate in a uint32_t too, the motions four times as hard stay finite with them
+void test_wide_metrics_stay_finite() {
+  char message[48];
+  for (uint8_t r = 0; r < num_recordings; r++) {
+    load_query(r, 4);
+    snprintf(message, sizeof(message), "recording %d scaled by 4", r);
+    for (uint8_t t = 0; t < dtw_num_templates; t++) {
+      TEST_ASSERT_LESS_THAN_UINT32_MESSAGE(ChebyshevMetric::infinity, window_dtw<ChebyshevMetric>(t, collecter), message);
+      TEST_ASSERT_LESS_THAN_UINT32_MESSAGE(MagnitudeMetric::infinity, window_dtw<MagnitudeMetric>(t, collecter), message);
+      TEST_ASSERT_LESS_THAN_UINT32_MESSAGE((WeightedL1Metric<8, 4, 2>::infinity),
+                                           (window_dtw<WeightedL1Metric<8, 4, 2>>(t, collecter)), message);
+      // With the default weights the weighted L1 is the L1
+      TEST_ASSERT_EQUAL_UINT32_MESSAGE(window_dtw<L1Metric>(t, collecter),
+                                       (window_dtw<WeightedL1Metric<4, 4, 4>>(t, collecter)), message);
+    }
+  }
+}
+
+/// @brief A recording performed twice as hard is still matched to a recording of the same gesture
+void test_harder_motions_keep_their_gesture() {
+  char message[48];
+  for (uint8_t r = 0; r < num_recordings; r++) {
+    load_query(r, 2);
+    snprintf(message, sizeof(message), "recording %d scaled by 2", r);
+    TEST_ASSERT_EQUAL_UINT8_MESSAGE(template_label(r), template_label(closest(dtw_unknown)), message);
+  }
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_engine_matches_full_matrix);
+  RUN_TEST(test_integer_kernels_pick_the_float_winner);
+  RUN_TEST(test_l1_cannot_saturate);
+  RUN_TEST(test_hard_motions_stay_finite);
+  RUN_TEST(test_wide_metrics_stay_finite);
+  RUN_TEST(test_harder_motions_keep_their_gesture);
+  return UNITY_END();
+}
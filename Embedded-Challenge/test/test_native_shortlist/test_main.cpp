@@ -0,0 +1,123 @@
+/*
+    Host tests of the feature shortlist (DTW_SHORTLIST in dtw.h), run with `pio test -e native`. Every recording of
+    src/gestures.h is classified against the centroids of src/gesture_tables.h through the shortlist, by the cascade
+    and by the time-sliced job, and both have to pick the gesture the batch cascade picks over every centroid.
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unity.h>
+
+// Minimal stand-ins for the Arduino functionalities used by the shared headers, as in tools/template_builder.cpp
+#define PROGMEM
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_ptr(addr) (*(void* const*)(addr))
+#define memcpy_P memcpy
+#ifndef min
+#define min(a, b) ((a) < (b) ? (a) : (b))
+#endif
+#ifndef max
+#define max(a, b) ((a) > (b) ? (a) : (b))
+#endif
+#define F_CPU 8000000L
+
+/// @brief A clock that goes up by a microsecond every time it is read, so that a slice of the job only takes a few steps
+unsigned long micros() {
+  static unsigned long now = 0;
+  return now++;
+}
+
+#define DTW_SHORTLIST 3
+
+#include "../../src/gestures.h"
+#include "../../src/gesture_tables.h"
+
+const uint8_t collecter_size = 20;
+int16_t collecter[collecter_size][3];
+
+#include "../../src/dtw.h"
+#include "../../src/dtw_job.h"
+
+const uint8_t num_recordings = sizeof(gestures) / sizeof(gestures[0]);
+
+/// @brief Fills the query with a recording, padded with its last sample or cut to collecter_size samples
+void load_recording(uint8_t r) {
+  const uint8_t m = gestures[r].length;
+  const int16_t* data = gestures[r].data;
+  for (uint8_t i = 0; i < collecter_size; i++) {
+    for (uint8_t k = 0; k < 3; k++) {
+      collecter[i][k] = data[min(i, m - 1) * 3 + k];
+    }
+  }
+}
+
+/// @brief The batch cascade of classify_cascade() over every template, as it runs without DTW_SHORTLIST
+uint8_t classify_batch(const int16_t query[][3], dtw_cost_t& distance) {
+  uint8_t chosen = dtw_unknown;
+  distance = DTW_INFINITY;
+  for (uint8_t t = 0; t < dtw_num_templates; t++) {
+    dtw_cost_t curr = DTW_INFINITY;
+    const dtw_cost_t bound = template_bound(t, distance);
+    if (lb_kim(t, query) <= bound && lb_keogh(t, query, bound) <= bound) {
+      curr = template_accept(t, calculate_DTW(t, query, bound));
+    }
+    if (curr < distance) {
+      distance = curr;
+      chosen = t;
+    }
+  }
+  return chosen;
+}
+
+/// @brief The shortlist keeps DTW_SHORTLIST templates, sorted by their feature distance
+void test_candidates() {
+  for (uint8_t r = 0; r < num_recordings; r++) {
+    load_recording(r);
+    uint8_t candidates[dtw_num_templates];
+    TEST_ASSERT_EQUAL_UINT8(DTW_SHORTLIST, dtw_candidates(collecter, candidates));
+    int16_t features[dtw_num_features];
+    dtw_features(collecter, collecter_size, features);
+    for (uint8_t k = 1; k < DTW_SHORTLIST; k++) {
+      TEST_ASSERT_TRUE(dtw_feature_distance(features, candidates[k - 1]) <= dtw_feature_distance(features, candidates[k]));
+    }
+  }
+}
+
+/// @brief The cascade over the candidates picks the gesture of the batch cascade over every template
+void test_cascade_matches_batch() {
+  char message[48];
+  for (uint8_t r = 0; r < num_recordings; r++) {
+    load_recording(r);
+    snprintf(message, sizeof(message), "recording %d", r);
+    dtw_cost_t distance;
+    const uint8_t batch = classify_batch(collecter, distance);
+    TEST_ASSERT_EQUAL_UINT8_MESSAGE(template_label(batch), template_label(classify_cascade(collecter, distance)), message);
+  }
+}
+
+/// @brief The time-sliced job goes through the same candidates, and picks the gesture of the batch cascade too
+void test_time_sliced_job_matches_batch() {
+  char message[48];
+  for (uint8_t r = 0; r < num_recordings; r++) {
+    load_recording(r);
+    snprintf(message, sizeof(message), "recording %d", r);
+    dtw_cost_t distance;
+    const uint8_t batch = classify_batch(collecter, distance);
+    DTW_job.begin(collecter);
+    while (!DTW_job.run(4)) {
+    }
+    TEST_ASSERT_EQUAL_UINT8_MESSAGE(template_label(batch), template_label(DTW_job.result()), message);
+  }
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_candidates);
+  RUN_TEST(test_cascade_matches_batch);
+  RUN_TEST(test_time_sliced_job_matches_batch);
+  return UNITY_END();
+}
@@ -0,0 +1,24 @@
+#ifdef __AVR__
+
+#include <avr/io.h>
+#include "unity_config.h"
+
+void unity_output_start() {
+  UBRR1 = F_CPU / 16 / 9600 - 1;
+  UCSR1B = (1 << TXEN1);
+  UCSR1C = (1 << UCSZ11) | (1 << UCSZ10); // 8N1
+}
+
+void unity_output_char(char c) {
+  while (!(UCSR1A & (1 << UDRE1))) {
+  }
+  UDR1 = c;
+}
+
+void unity_output_flush() {
+}
+
+void unity_output_complete() {
+}
+
+#endif
@@ -0,0 +1,31 @@
+/*
+    Unity output of the tests. On the board and under simavr, the results are written to USART1, since the USB serial
+    of the Arduino core isn't there without the framework. On the host, Unity's own putchar() output is kept.
+*/
+
+#ifndef UNITY_CONFIG_H
+#define UNITY_CONFIG_H
+
+#ifdef __AVR__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void unity_output_start();
+void unity_output_char(char c);
+void unity_output_flush();
+void unity_output_complete();
+
+#ifdef __cplusplus
+}
+#endif
+
+#define UNITY_OUTPUT_START() unity_output_start()
+#define UNITY_OUTPUT_CHAR(c) unity_output_char(c)
+#define UNITY_OUTPUT_FLUSH() unity_output_flush()
+#define UNITY_OUTPUT_COMPLETE() unity_output_complete()
+
+#endif
+
+#endif
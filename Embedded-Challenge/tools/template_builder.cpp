@@ -0,0 +1,698 @@
+/*
+    Host-side builder for the tables that are derived from the recordings in src/gestures.h. The tables are computed
+    once on the computer instead of on the board, and are written to src/gesture_tables.h so they end up in the flash
+    next to the recordings. The builder includes the same dtw.h as the firmware, so it has to be compiled with the same
+    DTW options (DTW_WINDOW, DTW_BAND_RADIUS, ...) that the firmware uses.
+
+    With DTW_CENTROIDS (the default), all the recordings of a gesture are first averaged into a single centroid, and
+    the firmware matches the query against the centroids instead of the recordings (see DTW_TEMPLATES in dtw.h). The
+    classification then costs the same however many recordings of each gesture are added to gestures.h. Building with
+    -DDTW_CENTROIDS=0 keeps matching against every recording.
+
+    With ORIENTATION_NORMALISE (which has to match the firmware's), the recordings are first rotated into the canonical
+    frame of orientation.h, so the tilt the board was held at no longer tells the recordings of a gesture apart. Without
+    centroids, the rotated recordings are written to gesture_tables.h and matched instead of those of gestures.h.
+
+    With DTW_PACKED_TEMPLATES, the templates are only written packed (see pack()), for a firmware built with the same
+    option. Without centroids or orientation, the recordings of gestures.h are then written packed as well, and the
+    firmware matches those instead.
+
+    From the Embedded-Challenge directory:
+        g++ -std=c++11 -O2 -o template_builder tools/template_builder.cpp
+        ./template_builder > src/gesture_tables.h
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+#include <string.h>
+#include <stdlib.h>
+
+// Minimal stand-ins for the Arduino functionalities used by the shared headers
+#define PROGMEM
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_ptr(addr) (*(void* const*)(addr))
+#ifndef min
+#define min(a, b) ((a) < (b) ? (a) : (b))
+#endif
+#ifndef max
+#define max(a, b) ((a) > (b) ? (a) : (b))
+#endif
+
+// Has to match the values in main.cpp
+#ifndef MAX_GESTURE_LEN
+#define MAX_GESTURE_LEN 2.99
+#endif
+#ifndef ACTIVE_FREQ
+#define ACTIVE_FREQ 7
+#endif
+
+#include "../src/gestures.h"
+
+const uint8_t collecter_size = ACTIVE_FREQ * MAX_GESTURE_LEN;
+
+// Whether the templates are written packed, for a firmware built with DTW_PACKED_TEMPLATES
+#if defined(DTW_PACKED_TEMPLATES) && DTW_PACKED_TEMPLATES
+#define PACK_TEMPLATES 1
+#else
+#define PACK_TEMPLATES 0
+#endif
+
+// The builder always works on the raw recordings
+#undef DTW_PACKED_TEMPLATES
+#define DTW_PACKED_TEMPLATES 0
+
+#include "../src/dtw.h"
+#include "../src/orientation.h"
+
+#ifndef DTW_CENTROIDS
+#define DTW_CENTROIDS 1
+#endif
+#ifndef DBA_ITERATIONS
+#define DBA_ITERATIONS 10 // The most refinement passes of the DBA, it stops earlier once a pass no longer helps
+#endif
+#ifndef DBA_MEDOIDS
+#define DBA_MEDOIDS 0 // Whether the medoid of every gesture is kept as is instead of being refined by the DBA
+#endif
+#ifndef DTW_REJECT_MARGIN
+#define DTW_REJECT_MARGIN 300 // How far, in percent of the furthest recording of a gesture, its threshold is set
+#endif
+#ifndef ORIENTATION_LEAD
+#define ORIENTATION_LEAD 1 // How many samples at the start of each recording gravity is estimated from
+#endif
+
+const uint8_t num_gestures = sizeof(gesture_names) / sizeof(gesture_names[0]);
+const uint8_t num_recordings = sizeof(gestures) / sizeof(gestures[0]);
+
+/// @brief A series the firmware matches the query against, either a recording or a centroid
+struct Template {
+  int16_t samples[dtw_max_length][3];
+  uint8_t length;
+  uint8_t label;
+  uint8_t trial;
+};
+
+Template templates[num_recordings];
+uint8_t num_templates = 0;
+
+/// @brief Prints the name of a template followed by the given suffix
+void print_name(uint8_t t, const char* suffix) {
+#if DTW_CENTROIDS
+  printf("centroid%d%s", templates[t].label, suffix);
+#else
+  if (templates[t].trial == 0) {
+    printf("gesture%d%s", templates[t].label, suffix);
+  }
+  else {
+    printf("gesture%d_%d%s", templates[t].label, templates[t].trial, suffix);
+  }
+#endif
+}
+
+/// @brief Prints a table in the flash pointing to the per-template arrays with the given suffix
+void print_table(const char* type, const char* table, const char* suffix) {
+  printf("const %s* const PROGMEM %s[] = {\n", type, table);
+  for (uint8_t t = 0; t < num_templates; t++) {
+    printf("    ");
+    print_name(t, suffix);
+    printf("%s\n", t + 1 < num_templates ? "," : "");
+  }
+  printf("};\n");
+}
+
+/*
+  The recordings everything is built from. With ORIENTATION_NORMALISE, they are rotated into the canonical frame of
+  orientation.h, with gravity estimated from their first ORIENTATION_LEAD samples, the same way the firmware rotates the
+  query.
+*/
+int16_t recordings[num_recordings][dtw_max_length][3];
+
+void load_recordings() {
+  for (uint8_t r = 0; r < num_recordings; r++) {
+    memcpy(recordings[r], gestures[r].data, gestures[r].length * sizeof(recordings[r][0]));
+#if ORIENTATION_NORMALISE
+    int16_t frame[3][3];
+    orientation_frame(recordings[r], ORIENTATION_LEAD, frame);
+    for (uint8_t j = 0; j < gestures[r].length; j++) {
+      orientation_rotate(frame, recordings[r][j]);
+    }
+    fprintf(stderr, "Recording %d: tilted %.0f degrees from the X axis\n", r, acos(frame[0][0] / (double) (1 << orientation_shift)) * 180 / M_PI);
+#endif
+  }
+}
+
+/*
+  DTW Barycenter Averaging (DBA). The centroid of a gesture starts as its medoid, the recording with the smallest sum of
+  DTW distances to the other recordings of the gesture. Every pass then aligns each recording against the centroid with
+  the DTW, and moves every centroid sample to the average of the recording samples that were matched to it. The passes
+  stop once they no longer lower the sum of the distances, and if the averaging never did better than the medoid, the
+  medoid is kept. The alignment is done over the whole DTW matrix with squared Euclidean costs, whose sum the average
+  minimises.
+*/
+typedef double Series[dtw_max_length][3];
+
+double dba_matrix[dtw_max_length][dtw_max_length];
+uint8_t dba_path[2 * dtw_max_length][2];
+uint8_t dba_path_len;
+
+/// @brief Computes the DTW distance between two series, and leaves their warping path in dba_path
+double dba_dtw(const Series a, uint8_t a_len, const Series b, uint8_t b_len) {
+  for (uint8_t i = 0; i < a_len; i++) {
+    for (uint8_t j = 0; j < b_len; j++) {
+      double cost = 0;
+      for (uint8_t k = 0; k < 3; k++) {
+        cost += (a[i][k] - b[j][k]) * (a[i][k] - b[j][k]);
+      }
+      double prev = 0;
+      if (i > 0 && j > 0) {
+        prev = fmin(dba_matrix[i - 1][j - 1], fmin(dba_matrix[i - 1][j], dba_matrix[i][j - 1]));
+      }
+      else if (i > 0) {
+        prev = dba_matrix[i - 1][j];
+      }
+      else if (j > 0) {
+        prev = dba_matrix[i][j - 1];
+      }
+      dba_matrix[i][j] = cost + prev;
+    }
+  }
+  uint8_t i = a_len - 1;
+  uint8_t j = b_len - 1;
+  dba_path_len = 0;
+  while (true) {
+    dba_path[dba_path_len][0] = i;
+    dba_path[dba_path_len][1] = j;
+    dba_path_len++;
+    if (i == 0 && j == 0) {
+      break;
+    }
+    if (i == 0) {
+      j--;
+    }
+    else if (j == 0) {
+      i--;
+    }
+    else if (dba_matrix[i - 1][j - 1] <= dba_matrix[i - 1][j] && dba_matrix[i - 1][j - 1] <= dba_matrix[i][j - 1]) {
+      i--;
+      j--;
+    }
+    else if (dba_matrix[i - 1][j] <= dba_matrix[i][j - 1]) {
+      i--;
+    }
+    else {
+      j--;
+    }
+  }
+  return dba_matrix[a_len - 1][b_len - 1];
+}
+
+Series dba_recordings[num_recordings];
+
+/// @brief Returns the sum of the DTW distances from a series to the given recordings
+double dba_inertia(const Series series, uint8_t len, const uint8_t* members, uint8_t num_members) {
+  double res = 0;
+  for (uint8_t r = 0; r < num_members; r++) {
+    res += dba_dtw(series, len, dba_recordings[members[r]], gestures[members[r]].length);
+  }
+  return res;
+}
+
+/// @brief Averages all the recordings of a gesture into a template
+void dba(uint8_t label, Template& centroid) {
+  uint8_t members[num_recordings];
+  uint8_t num_members = 0;
+  for (uint8_t r = 0; r < num_recordings; r++) {
+    if (gestures[r].label == label) {
+      members[num_members++] = r;
+    }
+  }
+
+  // The medoid
+  uint8_t medoid = members[0];
+  double medoid_inertia = INFINITY;
+  for (uint8_t m = 0; m < num_members; m++) {
+    double inertia = dba_inertia(dba_recordings[members[m]], gestures[members[m]].length, members, num_members);
+    if (inertia < medoid_inertia) {
+      medoid = members[m];
+      medoid_inertia = inertia;
+    }
+  }
+  const uint8_t len = gestures[medoid].length;
+  static Series series;
+  memcpy(series, dba_recordings[medoid], sizeof(series));
+  double inertia = medoid_inertia;
+
+  for (uint8_t pass = 0; pass < DBA_ITERATIONS && !DBA_MEDOIDS; pass++) {
+    static Series sums;
+    uint16_t counts[dtw_max_length] = {0};
+    memset(sums, 0, sizeof(sums));
+    for (uint8_t r = 0; r < num_members; r++) {
+      dba_dtw(series, len, dba_recordings[members[r]], gestures[members[r]].length);
+      for (uint8_t p = 0; p < dba_path_len; p++) {
+        for (uint8_t k = 0; k < 3; k++) {
+          sums[dba_path[p][0]][k] += recordings[members[r]][dba_path[p][1]][k];
+        }
+        counts[dba_path[p][0]]++;
+      }
+    }
+    static Series next;
+    for (uint8_t j = 0; j < len; j++) {
+      for (uint8_t k = 0; k < 3; k++) {
+        next[j][k] = round(sums[j][k] / counts[j]);
+      }
+    }
+    double next_inertia = dba_inertia(next, len, members, num_members);
+    if (next_inertia >= inertia) {
+      break;
+    }
+    memcpy(series, next, sizeof(series));
+    inertia = next_inertia;
+  }
+
+  fprintf(stderr, "Gesture %c: %d recordings, %s, %.0f instead of %.0f for the medoid\n", gesture_names[label], num_members,
+          inertia < medoid_inertia ? "averaged" : "medoid kept", inertia, medoid_inertia);
+  centroid.length = len;
+  centroid.label = label;
+  centroid.trial = gestures[medoid].trial;
+  for (uint8_t j = 0; j < len; j++) {
+    for (uint8_t k = 0; k < 3; k++) {
+      centroid.samples[j][k] = (int16_t) series[j][k];
+    }
+  }
+}
+
+/// @brief Fills the templates, either with the recordings or with their centroids
+void build_templates() {
+  for (uint8_t r = 0; r < num_recordings; r++) {
+    for (uint8_t j = 0; j < gestures[r].length; j++) {
+      for (uint8_t k = 0; k < 3; k++) {
+        dba_recordings[r][j][k] = recordings[r][j][k];
+      }
+    }
+  }
+#if DTW_CENTROIDS
+  for (uint8_t label = 0; label < num_gestures; label++) {
+    dba(label, templates[num_templates++]);
+  }
+#else
+  for (uint8_t r = 0; r < num_recordings; r++) {
+    Template& recording = templates[num_templates++];
+    recording.length = gestures[r].length;
+    recording.label = gestures[r].label;
+    recording.trial = gestures[r].trial;
+    memcpy(recording.samples, recordings[r], recording.length * sizeof(recording.samples[0]));
+  }
+#endif
+}
+
+/// @brief Prints the samples of every template, and a descriptor table pointing to them like the gestures table
+void print_templates(const char* table, const char* suffix) {
+  for (uint8_t t = 0; t < num_templates; t++) {
+    printf("const int16_t PROGMEM ");
+    print_name(t, suffix);
+    printf("[] = {\n");
+    for (uint8_t j = 0; j < templates[t].length; j++) {
+      printf("    %d, %d, %d,\n", templates[t].samples[j][0], templates[t].samples[j][1], templates[t].samples[j][2]);
+    }
+    printf("};\n\n");
+  }
+  printf("const GestureDescriptor PROGMEM %s[] = {\n", table);
+  for (uint8_t t = 0; t < num_templates; t++) {
+    printf("    { ");
+    print_name(t, suffix);
+    printf(", %d, %d, %d }%s\n", templates[t].length, templates[t].label, templates[t].trial, t + 1 < num_templates ? "," : "");
+  }
+  printf("};\n");
+}
+
+/*
+  Packing: every axis of a template is stored as signed byte codes around a base, value = base + code * scale. The base
+  is the middle of the axis' range and the scale is the smallest one that fits the range in [-127, 127]. The samples of
+  the templates are then replaced with the ones the firmware decodes, so that every other table (envelopes, coarse
+  templates, features, thresholds, SAX words) is built from what it actually matches against.
+*/
+int16_t packed_bases[num_recordings][3];
+uint8_t packed_scales[num_recordings][3];
+int8_t packed_codes[num_recordings][dtw_max_length][3];
+
+void pack() {
+  for (uint8_t t = 0; t < num_templates; t++) {
+    const Template& gesture = templates[t];
+    for (uint8_t k = 0; k < 3; k++) {
+      int16_t lo = INT16_MAX;
+      int16_t hi = INT16_MIN;
+      for (uint8_t j = 0; j < gesture.length; j++) {
+        lo = min(lo, gesture.samples[j][k]);
+        hi = max(hi, gesture.samples[j][k]);
+      }
+      int16_t base = (lo + hi) / 2;
+      int16_t spread = max(hi - base, base - lo);
+      uint8_t scale = max(1, (spread + 126) / 127);
+      packed_bases[t][k] = base;
+      packed_scales[t][k] = scale;
+      for (uint8_t j = 0; j < gesture.length; j++) {
+        long code = lround((double) (gesture.samples[j][k] - base) / scale);
+        packed_codes[t][j][k] = (int8_t) max(-127L, min(127L, code));
+      }
+    }
+  }
+  for (uint8_t t = 0; t < num_templates; t++) {
+    for (uint8_t j = 0; j < templates[t].length; j++) {
+      for (uint8_t k = 0; k < 3; k++) {
+        templates[t].samples[j][k] = packed_bases[t][k] + packed_codes[t][j][k] * packed_scales[t][k];
+      }
+    }
+  }
+}
+
+/// @brief Prints the codes of every packed template, and a descriptor table pointing to them with their bases and scales
+void print_packed(const char* table, const char* suffix) {
+  for (uint8_t t = 0; t < num_templates; t++) {
+    printf("const int8_t PROGMEM ");
+    print_name(t, suffix);
+    printf("[] = {\n");
+    for (uint8_t j = 0; j < templates[t].length; j++) {
+      printf("    %d, %d, %d,\n", packed_codes[t][j][0], packed_codes[t][j][1], packed_codes[t][j][2]);
+    }
+    printf("};\n\n");
+  }
+  printf("const PackedGestureDescriptor PROGMEM %s[] = {\n", table);
+  for (uint8_t t = 0; t < num_templates; t++) {
+    printf("    { ");
+    print_name(t, suffix);
+    printf(", {%d, %d, %d}, {%d, %d, %d}, %d, %d, %d }%s\n", packed_bases[t][0], packed_bases[t][1], packed_bases[t][2],
+           packed_scales[t][0], packed_scales[t][1], packed_scales[t][2], templates[t].length, templates[t].label,
+           templates[t].trial, t + 1 < num_templates ? "," : "");
+  }
+  printf("};\n");
+}
+
+/// @brief Prints the templates, packed with PACK_TEMPLATES, and the table describing them
+void print_stored(const char* table, const char* suffix) {
+#if PACK_TEMPLATES
+  print_packed(table, suffix);
+#else
+  print_templates(table, suffix);
+#endif
+}
+
+/*
+  LB_Keogh envelopes: for every query sample i, the per-axis maximum and minimum of the recording over the template
+  samples inside the DTW window of i.
+*/
+void print_envelopes() {
+  printf("// LB_Keogh envelopes, one { upper x, upper y, upper z, lower x, lower y, lower z } entry per query sample\n");
+  for (uint8_t t = 0; t < num_templates; t++) {
+    const Template& gesture = templates[t];
+    printf("const int16_t PROGMEM ");
+    print_name(t, "_envelope");
+    printf("[] = {\n");
+    for (uint8_t i = 0; i < collecter_size; i++) {
+      uint8_t lo, hi;
+      dtw_window(i, gesture.length, lo, hi);
+      int16_t upper[3] = {INT16_MIN, INT16_MIN, INT16_MIN};
+      int16_t lower[3] = {INT16_MAX, INT16_MAX, INT16_MAX};
+      for (uint8_t j = lo; j <= hi; j++) {
+        for (uint8_t k = 0; k < 3; k++) {
+          upper[k] = max(upper[k], gesture.samples[j][k]);
+          lower[k] = min(lower[k], gesture.samples[j][k]);
+        }
+      }
+      printf("    %d, %d, %d, %d, %d, %d,\n", upper[0], upper[1], upper[2], lower[0], lower[1], lower[2]);
+    }
+    printf("};\n\n");
+  }
+  print_table("int16_t", "gesture_envelopes", "_envelope");
+}
+
+/*
+  Coarse templates for the multi-resolution DTW: every template shrunk from its own length to dtw_coarse_size samples
+  with the same PAA that the firmware applies to the query.
+*/
+void print_coarse() {
+  printf("// Recordings averaged down to %d samples for the coarse pass of the multi-resolution DTW\n", dtw_coarse_size);
+  for (uint8_t t = 0; t < num_templates; t++) {
+    int16_t coarse[dtw_coarse_size][3];
+    dtw_paa(templates[t].samples, templates[t].length, coarse, dtw_coarse_size);
+    printf("const int16_t PROGMEM ");
+    print_name(t, "_coarse");
+    printf("[] = {\n");
+    for (uint8_t a = 0; a < dtw_coarse_size; a++) {
+      printf("    %d, %d, %d,\n", coarse[a][0], coarse[a][1], coarse[a][2]);
+    }
+    printf("};\n\n");
+  }
+  print_table("int16_t", "gesture_coarse", "_coarse");
+}
+
+/*
+  Rejection thresholds. Every recording of a gesture, padded with its last sample or cut to collecter_size samples like a
+  query, is matched against each template of the gesture with the same DTW as the firmware (same window, cell cost and
+  normalisation), over the whole window. The threshold of a template is the furthest of these distances, widened by
+  DTW_REJECT_MARGIN percent since a gesture only has a few recordings to go by.
+*/
+dtw_cost_t query_distance(const Template& gesture, const int16_t query[][3]) {
+  static dtw_cost_t matrix[collecter_size][dtw_max_length];
+  for (uint8_t i = 0; i < collecter_size; i++) {
+    uint8_t lo, hi;
+    dtw_window(i, gesture.length, lo, hi);
+    for (uint8_t j = 0; j < gesture.length; j++) {
+      if (j < lo || j > hi) {
+        matrix[i][j] = DTW_INFINITY;
+        continue;
+      }
+      dtw_cost_t prev = (i == 0 && j == 0) ? 0 : DTW_INFINITY;
+      if (i > 0 && j > 0) {
+        prev = min(prev, matrix[i - 1][j - 1]);
+      }
+      if (i > 0) {
+        prev = min(prev, matrix[i - 1][j]);
+      }
+      if (j > 0) {
+        prev = min(prev, matrix[i][j - 1]);
+      }
+      const int16_t* sample = gesture.samples[j];
+      matrix[i][j] = dtw_add(dtw_cell_cost(sample[0], sample[1], sample[2], query[i][0], query[i][1], query[i][2]), prev);
+    }
+  }
+  return dtw_normalise(matrix[collecter_size - 1][gesture.length - 1], gesture.length);
+}
+
+void print_thresholds() {
+#if DTW_KERNEL == DTW_KERNEL_FLOAT
+  const char* type = "float";
+#else
+  const char* type = (sizeof(dtw_cost_t) == 4) ? "uint32_t" : "uint16_t";
+#endif
+  printf("// Largest normalised DTW distance accepted for each template (see template_threshold in dtw.h)\n");
+  printf("const %s PROGMEM gesture_thresholds[] = {\n", type);
+  for (uint8_t t = 0; t < num_templates; t++) {
+    double furthest = 0;
+    for (uint8_t r = 0; r < num_recordings; r++) {
+      if (gestures[r].label != templates[t].label) {
+        continue;
+      }
+      int16_t query[collecter_size][3];
+      for (uint8_t i = 0; i < collecter_size; i++) {
+        const uint8_t j = min(i, gestures[r].length - 1);
+        for (uint8_t k = 0; k < 3; k++) {
+          query[i][k] = recordings[r][j][k];
+        }
+      }
+      furthest = fmax(furthest, (double) query_distance(templates[t], query));
+    }
+    const double threshold = fmin(furthest * DTW_REJECT_MARGIN / 100, (double) DTW_INFINITY);
+    fprintf(stderr, "Template %d (%c): furthest recording at %.0f, threshold %.0f\n", t, gesture_names[templates[t].label],
+            furthest, threshold);
+    printf(DTW_KERNEL == DTW_KERNEL_FLOAT ? "    %.2f%s\n" : "    %.0f%s\n", threshold, t + 1 < num_templates ? "," : "");
+  }
+  printf("};\n");
+}
+
+/// @brief Summary features of every template for the shortlist (see dtw_candidates in dtw.h)
+void print_features() {
+  printf("// Summary features, { mean, min, max, energy, crossings } for each axis (see dtw_features in dtw.h)\n");
+  printf("const int16_t PROGMEM gesture_features[][%d] = {\n", dtw_num_features);
+  for (uint8_t t = 0; t < num_templates; t++) {
+    int16_t features[dtw_num_features];
+    dtw_features(templates[t].samples, templates[t].length, features);
+    printf("    {");
+    for (uint8_t f = 0; f < dtw_num_features; f++) {
+      printf("%d%s", features[f], f + 1 < dtw_num_features ? ", " : "");
+    }
+    printf("}%s\n", t + 1 < num_templates ? "," : "");
+  }
+  printf("};\n");
+}
+
+/*
+  SAX index. The breakpoints of each axis split the samples of all the recordings into DTW_SAX_ALPHABET equally populated
+  cells. A template's word holds, for each segment of query samples and each axis, the range of cells covered by the
+  LB_Keogh envelope of the template over the windows of those query samples. The templates are then grouped into
+  buckets by their words, so the firmware only computes the MINDIST once for each distinct word.
+*/
+int16_t sax_breakpoints[3][DTW_SAX_ALPHABET - 1];
+uint8_t sax_words[num_recordings][DTW_SAX_SEGMENTS][3]; // lo | hi << 4
+
+int compare_int16(const void* a, const void* b) {
+  return *(const int16_t*) a - *(const int16_t*) b;
+}
+
+void sax_index() {
+  static int16_t values[num_recordings * dtw_max_length];
+  for (uint8_t k = 0; k < 3; k++) {
+    uint16_t num_values = 0;
+    for (uint8_t r = 0; r < num_recordings; r++) {
+      for (uint8_t j = 0; j < gestures[r].length; j++) {
+        values[num_values++] = recordings[r][j][k];
+      }
+    }
+    qsort(values, num_values, sizeof(values[0]), compare_int16);
+    for (uint8_t a = 0; a < DTW_SAX_ALPHABET - 1; a++) {
+      sax_breakpoints[k][a] = values[(uint32_t) (a + 1) * num_values / DTW_SAX_ALPHABET];
+    }
+  }
+  for (uint8_t t = 0; t < num_templates; t++) {
+    const Template& gesture = templates[t];
+    for (uint8_t s = 0; s < DTW_SAX_SEGMENTS; s++) {
+      int16_t upper[3] = {INT16_MIN, INT16_MIN, INT16_MIN};
+      int16_t lower[3] = {INT16_MAX, INT16_MAX, INT16_MAX};
+      for (uint8_t i = dtw_paa_start(s, collecter_size, DTW_SAX_SEGMENTS); i < dtw_paa_start(s + 1, collecter_size, DTW_SAX_SEGMENTS); i++) {
+        uint8_t lo, hi;
+        dtw_window(i, gesture.length, lo, hi);
+        for (uint8_t j = lo; j <= hi; j++) {
+          for (uint8_t k = 0; k < 3; k++) {
+            upper[k] = max(upper[k], gesture.samples[j][k]);
+            lower[k] = min(lower[k], gesture.samples[j][k]);
+          }
+        }
+      }
+      for (uint8_t k = 0; k < 3; k++) {
+        sax_words[t][s][k] = dtw_sax_symbol(lower[k], sax_breakpoints[k]) | dtw_sax_symbol(upper[k], sax_breakpoints[k]) << 4;
+      }
+    }
+  }
+}
+
+void print_sax_index() {
+  printf("// SAX breakpoints, DTW_SAX_ALPHABET - 1 for each axis (see dtw_sax_symbol in dtw.h)\n");
+  printf("const int16_t PROGMEM gesture_sax_breakpoints[][%d] = {\n", DTW_SAX_ALPHABET - 1);
+  for (uint8_t k = 0; k < 3; k++) {
+    printf("    {");
+    for (uint8_t a = 0; a < DTW_SAX_ALPHABET - 1; a++) {
+      printf("%d%s", sax_breakpoints[k][a], a + 2 < DTW_SAX_ALPHABET ? ", " : "");
+    }
+    printf("}%s\n", k < 2 ? "," : "");
+  }
+  printf("};\n\n");
+
+  // Grouping the templates that share a word
+  uint8_t bucket_of[num_recordings];
+  uint8_t bucket_words[num_recordings];
+  uint8_t num_buckets = 0;
+  for (uint8_t t = 0; t < num_templates; t++) {
+    bucket_of[t] = num_buckets;
+    for (uint8_t b = 0; b < num_buckets; b++) {
+      if (memcmp(sax_words[bucket_words[b]], sax_words[t], sizeof(sax_words[t])) == 0) {
+        bucket_of[t] = b;
+        break;
+      }
+    }
+    if (bucket_of[t] == num_buckets) {
+      bucket_words[num_buckets++] = t;
+    }
+  }
+  fprintf(stderr, "SAX index: %d buckets for %d templates\n", num_buckets, num_templates);
+
+  printf("// SAX words of the buckets, { lo | hi << 4 } for each segment and axis\n");
+  printf("const uint8_t PROGMEM gesture_sax_words[][%d] = {\n", DTW_SAX_SEGMENTS * 3);
+  for (uint8_t b = 0; b < num_buckets; b++) {
+    printf("    {");
+    for (uint8_t s = 0; s < DTW_SAX_SEGMENTS; s++) {
+      for (uint8_t k = 0; k < 3; k++) {
+        printf("0x%02X%s", sax_words[bucket_words[b]][s][k], s + 1 < DTW_SAX_SEGMENTS || k < 2 ? ", " : "");
+      }
+    }
+    printf("}%s\n", b + 1 < num_buckets ? "," : "");
+  }
+  printf("};\n\n");
+  printf("// The templates of bucket b are gesture_sax_members[gesture_sax_bucket_starts[b]] up to the start of bucket b + 1\n");
+  printf("const uint8_t PROGMEM gesture_sax_bucket_starts[] = {");
+  uint8_t start = 0;
+  for (uint8_t b = 0; b < num_buckets; b++) {
+    printf("%d, ", start);
+    for (uint8_t t = 0; t < num_templates; t++) {
+      start += bucket_of[t] == b;
+    }
+  }
+  printf("%d};\n", start);
+  printf("const uint8_t PROGMEM gesture_sax_members[] = {");
+  for (uint8_t b = 0; b < num_buckets; b++) {
+    for (uint8_t t = 0; t < num_templates; t++) {
+      if (bucket_of[t] == b) {
+        printf("%d%s", t, --start ? ", " : "");
+      }
+    }
+  }
+  printf("};\n");
+}
+
+int main() {
+  for (uint8_t r = 0; r < num_recordings; r++) {
+    if (gestures[r].length < dtw_coarse_size || gestures[r].length > dtw_max_length) {
+      fprintf(stderr, "Recording %d has %d samples, it has to have between %d and %d\n", r, gestures[r].length,
+              dtw_coarse_size, dtw_max_length);
+      return 1;
+    }
+  }
+  load_recordings();
+  build_templates();
+  printf("/*\n");
+  printf("    Generated by tools/template_builder.cpp from the recordings in gestures.h, don't edit by hand. The tables\n");
+  printf("    depend on the recordings and on the DTW options, so the builder has to be rerun whenever either changes.\n");
+  printf("*/\n\n");
+  printf("#ifdef __has_include\n");
+  printf("    #if __has_include(<Arduino.h>)\n");
+  printf("        #include <Arduino.h>\n");
+  printf("    #endif\n");
+  printf("#endif\n\n");
+  printf("#define GESTURE_TABLES_LEN %d\n", collecter_size);
+  printf("#define GESTURE_TABLES_WINDOW %d\n", DTW_WINDOW);
+  printf("#define GESTURE_TABLES_RADIUS %d\n", dtw_radius);
+  printf("#define GESTURE_TABLES_COARSE_LEN %d\n", dtw_coarse_size);
+  printf("#define GESTURE_TABLES_CENTROIDS %d\n", DTW_CENTROIDS);
+  printf("#define GESTURE_TABLES_ORIENTATION %d\n", ORIENTATION_NORMALISE);
+  printf("#define GESTURE_TABLES_KERNEL %d\n", DTW_KERNEL);
+  printf("#define GESTURE_TABLES_COST %d\n", DTW_COST);
+  printf("#define GESTURE_TABLES_SAX_SEGMENTS %d\n", DTW_SAX_SEGMENTS);
+  printf("#define GESTURE_TABLES_SAX_ALPHABET %d\n", DTW_SAX_ALPHABET);
+  printf("#define GESTURE_TABLES_PACKED %d\n\n", PACK_TEMPLATES);
+#if PACK_TEMPLATES
+  pack();
+#endif
+#if DTW_CENTROIDS
+  printf("// DBA centroids, one per gesture, averaged from all of its recordings in gestures.h\n");
+  print_stored("gesture_centroids", "");
+  printf("\n");
+#elif ORIENTATION_NORMALISE
+  printf("// The recordings of gestures.h rotated into the canonical frame of orientation.h\n");
+  print_stored("gesture_oriented", "_oriented");
+  printf("\n");
+#elif PACK_TEMPLATES
+  printf("// The recordings of gestures.h, packed into one signed byte per axis (see GestureReader in dtw.h)\n");
+  print_packed("gesture_packed", "_packed");
+  printf("\n");
+#endif
+  print_envelopes();
+  printf("\n");
+  print_coarse();
+  printf("\n");
+  print_features();
+  printf("\n");
+  print_thresholds();
+  printf("\n");
+  sax_index();
+  print_sax_index();
+  return 0;
+}